@@ -0,0 +1,265 @@
+#ifndef AUTOSORT_HPP
+#define AUTOSORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "DistributionSort.hpp"
+#include "HybridSort.hpp"
+#include "IndirectSort.hpp"
+#include "MergeSort.hpp"
+#include "OddEvenSort.hpp"
+#include "QuickSort.hpp"
+#include "StringSort.hpp"
+#include "Verify.hpp"
+
+namespace gorbunova {
+  enum class Engine {
+    none,
+    reversal,
+    oddEven,
+    quick,
+    merge,
+    counting,
+    distribution,
+    string,
+    staged,
+    indirect
+  };
+
+  inline const char* engineName(Engine engine)
+  {
+    static constexpr const char* names[] = {
+      "none", "reversal", "oddEven", "quick", "merge", "counting", "distribution", "string", "staged", "indirect"
+    };
+    return names[static_cast< size_t >(engine)];
+  }
+
+  struct SortPlan {
+    Engine engine;
+    size_t size;
+    size_t sampled;
+    size_t ascending;
+    size_t descending;
+    size_t distinct;
+  };
+
+  template< typename Iter, typename Compare >
+  Engine autoSort(Iter first, Iter last, Compare cmp, std::ostream* log = nullptr);
+}
+
+namespace {
+  constexpr size_t sampleSize = 64;
+  constexpr size_t smallSortThreshold = 16;
+  constexpr size_t indirectThreshold = 64;
+  constexpr size_t countingRangeFactor = 4;
+
+  template< typename T >
+  constexpr bool isCountable = std::is_integral_v< T > && !std::is_same_v< T, bool >;
+
+  template< typename T, typename Compare >
+  constexpr bool isAscendingOrder = std::is_same_v< Compare, std::less<> > || std::is_same_v< Compare, std::less< T > >;
+
+  template< typename T, typename Compare >
+  constexpr bool isDescendingOrder = std::is_same_v< Compare, std::greater<> >
+    || std::is_same_v< Compare, std::greater< T > >;
+
+  struct AutoSorter {
+    std::ostream* log;
+
+    template< typename Iter, typename Compare >
+    void operator()(Iter first, Iter last, Compare cmp) const
+    {
+      gorbunova::autoSort(first, last, cmp, log);
+    }
+  };
+
+  template< typename T >
+  size_t keyRange(T low, T high)
+  {
+    using Unsigned = std::make_unsigned_t< T >;
+    return static_cast< Unsigned >(static_cast< Unsigned >(high) - static_cast< Unsigned >(low));
+  }
+
+  // Counts every key in [min, max] and writes the distinct keys back in cmp order.
+  // Gives up without touching the range when the keys span more than countingRangeFactor * size values.
+  template< typename Iter, typename Compare >
+  bool countingSort(Iter first, Iter last, Compare cmp)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    auto bounds = std::minmax_element(first, last);
+    value low = *bounds.first;
+    size_t range = keyRange(low, *bounds.second);
+    size_t size = last - first;
+    if (range / countingRangeFactor >= size) {
+      return false;
+    }
+    std::vector< size_t > counts(range + 1);
+    for (Iter it = first; it != last; ++it) {
+      ++counts[keyRange(low, *it)];
+    }
+    std::vector< value > keys;
+    for (size_t key = 0; key <= range; ++key) {
+      if (counts[key] != 0) {
+        keys.push_back(static_cast< value >(low + static_cast< value >(key)));
+      }
+    }
+    gorbunova::mergeSort(keys.begin(), keys.end(), cmp);
+    for (const value& key : keys) {
+      first = std::fill_n(first, counts[keyRange(low, key)], key);
+    }
+    return true;
+  }
+}
+
+namespace gorbunova {
+  template< typename Iter, typename Compare >
+  SortPlan planSort(Iter first, Iter last, Compare cmp)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    SortPlan plan{ Engine::none, static_cast< size_t >(std::distance(first, last)), 0, 0, 0, 0 };
+    if (plan.size < 2) {
+      return plan;
+    }
+    if constexpr (!isRandomAccess< Iter >) {
+      plan.engine = isStageable< Iter > ? Engine::staged : Engine::indirect;
+      return plan;
+    } else {
+      if (plan.size <= smallSortThreshold) {
+        plan.engine = Engine::oddEven;
+        return plan;
+      }
+      if constexpr (sizeof(value) > indirectThreshold) {
+        plan.engine = Engine::indirect;
+        return plan;
+      }
+      if constexpr (std::is_same_v< value, std::string >
+          && (isAscendingOrder< value, Compare > || isDescendingOrder< value, Compare >)) {
+        plan.engine = Engine::string;
+        return plan;
+      }
+
+      plan.sampled = std::min(plan.size, sampleSize);
+      std::vector< value > sample;
+      for (size_t i = 0; i < plan.sampled; ++i) {
+        sample.push_back(first[(plan.size - 1) * i / (plan.sampled - 1)]);
+      }
+      for (size_t i = 1; i < plan.sampled; ++i) {
+        plan.ascending += !cmp(sample[i], sample[i - 1]);
+        plan.descending += !cmp(sample[i - 1], sample[i]);
+      }
+      gorbunova::mergeSort(sample.begin(), sample.end(), cmp);
+      plan.distinct = 1;
+      for (size_t i = 1; i < plan.sampled; ++i) {
+        plan.distinct += cmp(sample[i - 1], sample[i]);
+      }
+
+      bool narrow = false;
+      if constexpr (isCountable< value >) {
+        value low = std::min(sample.front(), sample.back());
+        narrow = keyRange(low, std::max(sample.front(), sample.back())) / countingRangeFactor < plan.size;
+      }
+      size_t pairs = plan.sampled - 1;
+      if (plan.ascending == pairs && isSortedRange(first, last, cmp)) {
+        plan.engine = Engine::none;
+      } else if (plan.descending == pairs && isSortedRange(first, last, [&cmp](const value& lhs, const value& rhs) {
+        return cmp(rhs, lhs);
+      })) {
+        plan.engine = Engine::reversal;
+      } else if (narrow) {
+        plan.engine = Engine::counting;
+      } else if (plan.ascending * 10 >= pairs * 9 || plan.descending * 10 >= pairs * 9) {
+        plan.engine = Engine::merge;
+      } else if (std::is_arithmetic_v< value > && plan.size > distributionBaseCase) {
+        plan.engine = Engine::distribution;
+      } else if (plan.distinct * 2 < plan.sampled) {
+        plan.engine = Engine::merge;
+      } else {
+        plan.engine = Engine::quick;
+      }
+      return plan;
+    }
+  }
+
+  // Picks an engine from the iterator category, the element type and a sample of the input.
+  // Returns the engine that sorted the range and, if log is given, writes one line about the choice;
+  // staged and indirect sorts continue that line with the choice made for the buffer they sort.
+  template< typename Iter, typename Compare >
+  Engine autoSort(Iter first, Iter last, Compare cmp, std::ostream* log)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    SortPlan plan = planSort(first, last, cmp);
+    bool nested = plan.engine == Engine::staged || plan.engine == Engine::indirect;
+    if (log) {
+      *log << plan.size << " elements";
+      if (plan.sampled != 0) {
+        *log << ", sampled " << plan.sampled << " (" << plan.ascending << " ascending, " << plan.descending;
+        *log << " descending, " << plan.distinct << " distinct)";
+      }
+      if (nested) {
+        *log << " -> " << engineName(plan.engine) << " -> ";
+      }
+    }
+    if constexpr (!isRandomAccess< Iter >) {
+      if (plan.engine == Engine::staged) {
+        if constexpr (isStageable< Iter >) {
+          stagedSort(first, last, cmp, AutoSorter{ log });
+        }
+      } else if (plan.engine == Engine::indirect) {
+        indirectSort(first, last, cmp, AutoSorter{ log });
+      }
+    } else {
+      switch (plan.engine) {
+        case Engine::none:
+        case Engine::staged:
+          break;
+        case Engine::reversal:
+          std::reverse(first, last);
+          break;
+        case Engine::oddEven:
+          oddEvenSort(first, last, cmp);
+          break;
+        case Engine::quick:
+          quickSort(first, last, cmp);
+          break;
+        case Engine::merge:
+          mergeSort(first, last, cmp);
+          break;
+        case Engine::counting:
+          if constexpr (isCountable< value >) {
+            if (!countingSort(first, last, cmp)) {
+              plan.engine = Engine::merge;
+              mergeSort(first, last, cmp);
+            }
+          }
+          break;
+        case Engine::distribution:
+          if constexpr (std::is_arithmetic_v< value >) {
+            distributionSort(first, last, cmp);
+          }
+          break;
+        case Engine::string:
+          if constexpr (std::is_same_v< value, std::string >) {
+            stringSort(first, last, isDescendingOrder< value, Compare >);
+          }
+          break;
+        case Engine::indirect:
+          if constexpr (sizeof(value) > indirectThreshold) {
+            indirectSort(first, last, cmp, AutoSorter{ log });
+          }
+          break;
+      }
+    }
+    if (log && !nested) {
+      *log << " -> " << engineName(plan.engine) << '\n';
+    }
+    return plan.engine;
+  }
+}
+
+#endif
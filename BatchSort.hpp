@@ -0,0 +1,218 @@
+#ifndef BATCHSORT_HPP
+#define BATCHSORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "QuickSort.hpp"
+#include "ThreadPool.hpp"
+
+namespace gorbunova {
+  struct Segment {
+    size_t offset;
+    size_t length;
+  };
+}
+
+namespace {
+  constexpr size_t laneWidth = 8;
+  constexpr size_t maxNetworkSize = 64;
+  constexpr size_t segmentsPerTask = 4096;
+
+  template< size_t N, typename F >
+  constexpr void forEachComparator(F f)
+  {
+    for (size_t p = 1; p < N; p *= 2) {
+      for (size_t k = p; k >= 1; k /= 2) {
+        for (size_t j = k % p; j + k < N; j += 2 * k) {
+          for (size_t i = 0; i < k && i + j + k < N; ++i) {
+            if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+              f(i + j, i + j + k);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  template< size_t N >
+  constexpr size_t comparatorsCount()
+  {
+    size_t count = 0;
+    forEachComparator< N >([&count](size_t, size_t) {
+      ++count;
+    });
+    return count;
+  }
+
+  template< size_t N >
+  struct Network {
+    using Comparator = std::pair< unsigned char, unsigned char >;
+    static constexpr size_t size = comparatorsCount< N >();
+
+    static constexpr std::array< Comparator, size > make()
+    {
+      std::array< Comparator, size > comparators{};
+      size_t count = 0;
+      forEachComparator< N >([&](size_t a, size_t b) {
+        comparators[count++] = Comparator(static_cast< unsigned char >(a), static_cast< unsigned char >(b));
+      });
+      return comparators;
+    }
+
+    static constexpr std::array< Comparator, size > comparators = make();
+  };
+
+  template< typename T, typename Compare >
+  void compareExchange(T* first, T* second, Compare& cmp)
+  {
+    T low[laneWidth];
+    T high[laneWidth];
+    for (size_t w = 0; w < laneWidth; ++w) {
+      bool swapped = cmp(second[w], first[w]);
+      low[w] = swapped ? second[w] : first[w];
+      high[w] = swapped ? first[w] : second[w];
+    }
+    std::copy(low, low + laneWidth, first);
+    std::copy(high, high + laneWidth, second);
+  }
+
+  template< size_t N, typename T, typename Compare, size_t... I >
+  void applyNetwork(T (&lanes)[N][laneWidth], Compare& cmp, std::index_sequence< I... >)
+  {
+    (compareExchange(lanes[Network< N >::comparators[I].first], lanes[Network< N >::comparators[I].second], cmp), ...);
+  }
+
+  template< size_t N, typename T, typename Compare >
+  void sortGroup(T* data, const gorbunova::Segment* segments, size_t count, Compare& cmp)
+  {
+    T lanes[N][laneWidth];
+    for (size_t w = 0; w < laneWidth; ++w) {
+      if (w >= count) {
+        for (size_t k = 0; k < N; ++k) {
+          lanes[k][w] = lanes[k][0];
+        }
+        continue;
+      }
+      const T* source = data + segments[w].offset;
+      size_t length = segments[w].length;
+      T greatest = source[0];
+      for (size_t k = 0; k < length; ++k) {
+        lanes[k][w] = source[k];
+        if (cmp(greatest, source[k])) {
+          greatest = source[k];
+        }
+      }
+      for (size_t k = length; k < N; ++k) {
+        lanes[k][w] = greatest;
+      }
+    }
+    applyNetwork< N >(lanes, cmp, std::make_index_sequence< Network< N >::size >());
+    for (size_t w = 0; w < count; ++w) {
+      T* target = data + segments[w].offset;
+      for (size_t k = 0; k < segments[w].length; ++k) {
+        target[k] = lanes[k][w];
+      }
+    }
+  }
+
+  template< size_t N, typename T, typename Compare >
+  void sortBucket(T* data, const gorbunova::Segment* segments, size_t count, Compare cmp)
+  {
+    for (size_t i = 0; i < count; i += laneWidth) {
+      sortGroup< N >(data, segments + i, std::min(laneWidth, count - i), cmp);
+    }
+  }
+
+  template< typename T, typename Compare >
+  void sortSegments(T* data, size_t network, const gorbunova::Segment* segments, size_t count, Compare cmp)
+  {
+    switch (network) {
+      case 4:
+        sortBucket< 4 >(data, segments, count, cmp);
+        break;
+      case 8:
+        sortBucket< 8 >(data, segments, count, cmp);
+        break;
+      case 16:
+        sortBucket< 16 >(data, segments, count, cmp);
+        break;
+      case 32:
+        sortBucket< 32 >(data, segments, count, cmp);
+        break;
+      case 64:
+        sortBucket< 64 >(data, segments, count, cmp);
+        break;
+      default:
+        for (size_t i = 0; i < count; ++i) {
+          T* first = data + segments[i].offset;
+          gorbunova::quickSort(first, first + segments[i].length, cmp);
+        }
+    }
+  }
+
+  constexpr size_t networkFor(size_t length)
+  {
+    size_t network = 4;
+    while (network < length && network <= maxNetworkSize) {
+      network *= 2;
+    }
+    return network;
+  }
+}
+
+namespace gorbunova {
+  // Segments must not overlap; segments longer than 64 elements fall back to quickSort.
+  template< typename T, typename Compare >
+  void batchSort(T* data, const std::vector< Segment >& segments, Compare cmp, ThreadPool* pool = nullptr)
+  {
+    std::array< std::vector< Segment >, 6 > buckets;
+    for (const Segment& segment : segments) {
+      if (segment.length > 1) {
+        size_t network = networkFor(segment.length);
+        size_t bucket = 0;
+        while ((size_t(4) << bucket) < network) {
+          ++bucket;
+        }
+        buckets[bucket].push_back(segment);
+      }
+    }
+    std::vector< std::future< void > > tasks;
+    for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+      size_t network = size_t(4) << bucket;
+      const std::vector< Segment >& group = buckets[bucket];
+      for (size_t i = 0; i < group.size(); i += segmentsPerTask) {
+        const Segment* first = group.data() + i;
+        size_t count = std::min(segmentsPerTask, group.size() - i);
+        if (pool) {
+          tasks.push_back(pool->submit([data, network, first, count, cmp]() {
+            sortSegments(data, network, first, count, cmp);
+          }));
+        } else {
+          sortSegments(data, network, first, count, cmp);
+        }
+      }
+    }
+    for (std::future< void >& task : tasks) {
+      task.get();
+    }
+  }
+
+  template< typename T, typename Compare >
+  void batchSort(std::vector< T >& data, const std::vector< Segment >& segments, Compare cmp,
+      ThreadPool* pool = nullptr)
+  {
+    for (const Segment& segment : segments) {
+      if (segment.offset > data.size() || segment.length > data.size() - segment.offset) {
+        throw std::out_of_range("Segment is out of range");
+      }
+    }
+    batchSort(data.data(), segments, cmp, pool);
+  }
+}
+
+#endif
@@ -0,0 +1,403 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "SortCollections.hpp"
+#include "CompactList.hpp"
+#include "ConcurrentForwardList.hpp"
+#include "BatchSort.hpp"
+
+namespace {
+  template< typename F >
+  double measure(F f)
+  {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration< double, std::milli > elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  template< typename List, typename Sorter, typename Compare >
+  std::ostream& compareStaging(std::ostream& out, const std::string& name, const List& source, Sorter sorter,
+      Compare cmp)
+  {
+    List inPlace(source);
+    List staged(source);
+    double inPlaceTime = measure([&]() {
+      sorter(inPlace.begin(), inPlace.end(), cmp);
+    });
+    double stagedTime = measure([&]() {
+      gorbunova::stagedSort(staged.begin(), staged.end(), cmp, sorter);
+    });
+    out << name << ": in-place " << inPlaceTime << " ms, staged " << stagedTime << " ms";
+    if (stagedTime > 0) {
+      out << ", x" << inPlaceTime / stagedTime;
+    }
+    return out << '\n';
+  }
+
+  template< typename T, typename Plain, typename Sorter >
+  std::ostream& compareSegmented(std::ostream& out, const std::string& name, const std::deque< T >& source,
+      Plain plain, Sorter sorter)
+  {
+    std::deque< T > iterated(source);
+    std::deque< T > segmented(source);
+    std::vector< T > contiguous(source.begin(), source.end());
+    double iteratedTime = measure([&]() {
+      plain(iterated.begin(), iterated.end());
+    });
+    double segmentedTime = measure([&]() {
+      sorter(segmented.begin(), segmented.end());
+    });
+    double contiguousTime = measure([&]() {
+      sorter(contiguous.begin(), contiguous.end());
+    });
+    out << name << " deque: iterator " << iteratedTime << " ms, segmented " << segmentedTime;
+    return out << " ms, vector " << contiguousTime << " ms\n";
+  }
+
+  template< typename T >
+  void fillCompact(gorbunova::CompactList< T >& b, std::deque< T >& d)
+  {
+    b.reserve(d.size());
+    for (auto it = d.begin(); it != d.end(); ++it) {
+      b.pushBack(*it);
+    }
+  }
+
+  template< typename Node >
+  void scatterHeap(size_t count)
+  {
+    std::vector< void* > blocks(count);
+    for (void*& block : blocks) {
+      block = ::operator new(sizeof(Node));
+    }
+    std::shuffle(blocks.begin(), blocks.end(), std::mt19937(std::rand()));
+    for (void* block : blocks) {
+      ::operator delete(block);
+    }
+  }
+
+  template< typename List >
+  std::ostream& compareTraversal(std::ostream& out, const std::string& name, const std::deque<
+      typename List::Iterator::value_type >& data)
+  {
+    using value = typename List::Iterator::value_type;
+    scatterHeap< typename List::Node >(data.size());
+    List list;
+    for (const value& item : data) {
+      list.pushBack(item);
+    }
+    volatile uint64_t sum = 0;
+    auto touch = [&sum](const value& item) {
+      sum = sum + mixHash(std::hash< value >()(item));
+    };
+    double scattered = measure([&]() {
+      for (auto it = list.begin(); it != list.end(); ++it) {
+        touch(*it);
+      }
+    });
+    list.compact();
+    double compacted = measure([&]() {
+      for (auto it = list.begin(); it != list.end(); ++it) {
+        touch(*it);
+      }
+    });
+    out << "traversal " << name << ": scattered " << scattered << " ms, compacted " << compacted << " ms\n";
+    return out;
+  }
+
+  template< typename F >
+  double measureProducers(size_t producers, size_t size, F produce)
+  {
+    return measure([&]() {
+      std::vector< std::thread > threads;
+      for (size_t i = 0; i < producers; ++i) {
+        threads.emplace_back(produce, size / producers + (i < size % producers));
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    });
+  }
+}
+
+namespace gorbunova {
+  template< typename T >
+  std::ostream& benchmarkStaging(std::ostream& out, size_t size, const std::string& direction)
+  {
+    std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+    std::deque< T > data;
+    for (size_t i = 0; i < size; ++i) {
+      data.push_back(getRandom< T >());
+    }
+    BidirectionalList< T > bidirectional;
+    ForwardList< T > forward;
+    fillBidirectional(bidirectional, data);
+    fillForward(forward, data);
+
+    compareStaging(out, "quickSort BidirectionalList", bidirectional, QuickSorter(), cmp);
+    compareStaging(out, "quickSort ForwardList", forward, QuickSorter(), cmp);
+    return compareStaging(out, "oddEvenSort BidirectionalList", bidirectional, OddEvenSorter(), cmp);
+  }
+
+  template< typename T >
+  std::ostream& benchmarkPartition(std::ostream& out, size_t size, const std::string& direction)
+  {
+    if constexpr (std::is_arithmetic_v< T >) {
+      std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+      std::deque< T > scalar = generateCollection< T >(size);
+      std::deque< T > block(scalar);
+      if (size > 0) {
+        double scalarTime = measure([&]() {
+          ::partition(scalar.begin(), scalar.end(), cmp);
+        });
+        double blockTime = measure([&]() {
+          ::blockPartition(block.begin(), block.end(), cmp);
+        });
+        out << "partition std::deque: scalar " << scalarTime << " ms, block " << blockTime << " ms\n";
+      }
+    }
+    return out;
+  }
+
+  template< typename T >
+  std::ostream& benchmarkBatch(std::ostream& out, size_t size)
+  {
+    if constexpr (std::is_arithmetic_v< T >) {
+      std::vector< T > batched;
+      std::vector< Segment > segments;
+      while (batched.size() < size) {
+        size_t length = std::min< size_t >(4 + std::rand() % 61, size - batched.size());
+        segments.push_back(Segment{ batched.size(), length });
+        for (size_t i = 0; i < length; ++i) {
+          batched.push_back(getRandom< T >());
+        }
+      }
+      if (segments.empty()) {
+        return out;
+      }
+      std::vector< T > separate(batched);
+      double separateTime = measure([&]() {
+        for (const Segment& segment : segments) {
+          quickSort(separate.begin() + segment.offset, separate.begin() + segment.offset + segment.length,
+              std::less<>());
+        }
+      });
+      double batchedTime = measure([&]() {
+        batchSort(batched, segments, std::less<>());
+      });
+      double perSegment = 1e6 / segments.size();
+      out << "small segments: quickSort " << separateTime * perSegment << " ns/segment, batchSort ";
+      out << batchedTime * perSegment << " ns/segment\n";
+    }
+    return out;
+  }
+
+  template< typename T >
+  std::ostream& benchmarkSegmented(std::ostream& out, size_t size, const std::string& direction)
+  {
+    std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+    std::deque< T > data = generateCollection< T >(size);
+    compareSegmented(out, "quickSort", data, [&cmp](auto first, auto last) {
+      quickSortRange(first, last, cmp);
+    }, [&cmp](auto first, auto last) {
+      quickSort(first, last, cmp);
+    });
+    compareSegmented(out, "mergeSort", data, [&cmp](auto first, auto last) {
+      mergeSortRange(first, last, cmp);
+    }, [&cmp](auto first, auto last) {
+      mergeSort(first, last, cmp);
+    });
+    return compareSegmented(out, "oddEvenSort", data, [&cmp](auto first, auto last) {
+      oddEvenSortRange(first, last, cmp);
+    }, [&cmp](auto first, auto last) {
+      oddEvenSort(first, last, cmp);
+    });
+  }
+
+  template< typename T >
+  std::ostream& benchmarkMemory(std::ostream& out, size_t size, const std::string& direction)
+  {
+    std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+    std::deque< T > data = generateCollection< T >(size);
+    std::deque< T > buffered(data);
+    double bufferedTime = measure([&]() {
+      mergeSort(buffered.begin(), buffered.end(), cmp, unlimitedMemory);
+    });
+    out << "mergeSort memory: unlimited " << bufferedTime << " ms";
+    size_t root = 1;
+    while (root * root < size) {
+      ++root;
+    }
+    for (size_t budget : { size_t(0), root * sizeof(T) }) {
+      std::deque< T > bounded(data);
+      double boundedTime = measure([&]() {
+        mergeSort(bounded.begin(), bounded.end(), cmp, budget);
+      });
+      out << ", " << budget << " bytes " << boundedTime << " ms";
+    }
+    return out << '\n';
+  }
+
+  template< typename T >
+  std::ostream& benchmarkLazy(std::ostream& out, size_t size, const std::string& direction)
+  {
+    std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+    std::deque< T > data = generateCollection< T >(size);
+    out << "sortedView:";
+    for (size_t count : { size_t(1), size_t(10), size }) {
+      double lazyTime = measure([&]() {
+        for (const T& value : take(sortedView(data.begin(), data.end(), cmp), count)) {
+          static_cast< void >(value);
+        }
+      });
+      out << " first " << count << " in " << lazyTime << " ms,";
+    }
+    double fullTime = measure([&]() {
+      quickSort(data.begin(), data.end(), cmp);
+    });
+    return out << " quickSort " << fullTime << " ms\n";
+  }
+
+  template< typename T >
+  std::ostream& benchmarkDistribution(std::ostream& out, size_t size, const std::string& direction)
+  {
+    if constexpr (std::is_arithmetic_v< T >) {
+      std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+      std::deque< T > data = generateCollection< T >(size);
+      BidirectionalList< T > list;
+      fillBidirectional(list, data);
+      std::deque< T > quick(data);
+      BidirectionalList< T > quickList(list);
+      double quickTime = measure([&]() {
+        quickSort(quick.begin(), quick.end(), cmp);
+      });
+      double distributionTime = measure([&]() {
+        distributionSort(data.begin(), data.end(), cmp);
+      });
+      double quickListTime = measure([&]() {
+        quickSort(quickList.begin(), quickList.end(), cmp);
+      });
+      double distributionListTime = measure([&]() {
+        distributionSort(list.begin(), list.end(), cmp);
+      });
+      out << "distributionSort std::deque: " << distributionTime << " ms, quickSort " << quickTime << " ms\n";
+      out << "distributionSort BidirectionalList: " << distributionListTime << " ms, quickSort " << quickListTime;
+      out << " ms\n";
+    }
+    return out;
+  }
+
+  template< typename T >
+  std::ostream& benchmarkTraversal(std::ostream& out, size_t size)
+  {
+    std::deque< T > data = generateCollection< T >(size);
+    compareTraversal< BidirectionalList< T > >(out, "BidirectionalList", data);
+    return compareTraversal< ForwardList< T > >(out, "ForwardList", data);
+  }
+
+  // Node memory excludes the allocator's per-allocation header, which BidirectionalList pays once per node
+  // and CompactList once for the whole arena.
+  template< typename T >
+  std::ostream& benchmarkCompact(std::ostream& out, size_t size, const std::string& direction)
+  {
+    if constexpr (std::is_trivially_destructible_v< T >) {
+      std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+      std::deque< T > data = generateCollection< T >(size);
+      BidirectionalList< T > list;
+      fillBidirectional(list, data);
+      CompactList< T > compact;
+      fillCompact(compact, data);
+      volatile T sink = T();
+      double listTraversal = measure([&]() {
+        for (auto it = list.begin(); it != list.end(); ++it) {
+          sink = *it;
+        }
+      });
+      double compactTraversal = measure([&]() {
+        for (auto it = compact.begin(); it != compact.end(); ++it) {
+          sink = *it;
+        }
+      });
+      double listTime = measure([&]() {
+        quickSort(list.begin(), list.end(), cmp);
+      });
+      double compactTime = measure([&]() {
+        quickSort(compact.begin(), compact.end(), cmp);
+      });
+      out << "node memory: BidirectionalList " << list.getSize() * sizeof(typename BidirectionalList< T >::Node);
+      out << " bytes, CompactList " << compact.getCapacity() * sizeof(typename CompactList< T >::Node) << " bytes\n";
+      out << "traversal: BidirectionalList " << listTraversal << " ms, CompactList " << compactTraversal << " ms\n";
+      out << "quickSort: BidirectionalList " << listTime << " ms, CompactList " << compactTime << " ms\n";
+    }
+    return out;
+  }
+
+  template< typename T >
+  std::ostream& benchmarkIndirect(std::ostream& out, size_t size, const std::string& direction)
+  {
+    using Payload = std::array< T, 32 >;
+    std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+    auto payloadCmp = [&cmp](const Payload& lhs, const Payload& rhs) {
+      return cmp(lhs[0], rhs[0]);
+    };
+    auto keyOf = [](const Payload& payload) {
+      return payload[0];
+    };
+    std::deque< Payload > direct;
+    for (size_t i = 0; i < size; ++i) {
+      direct.push_back(Payload{ getRandom< T >() });
+    }
+    std::deque< Payload > indirect(direct);
+    double directTime = measure([&]() {
+      gorbunova::quickSort(direct.begin(), direct.end(), payloadCmp);
+    });
+    double indirectTime = measure([&]() {
+      gorbunova::indirectSort(indirect.begin(), indirect.end(), cmp, QuickSorter(), keyOf);
+    });
+    out << "quickSort " << sizeof(Payload) << "-byte payloads: direct " << directTime << " ms, indirect ";
+    out << indirectTime << " ms";
+    if (indirectTime > 0) {
+      out << ", x" << directTime / indirectTime;
+    }
+    return out << '\n';
+  }
+
+  template< typename T >
+  std::ostream& benchmarkIngestion(std::ostream& out, size_t size)
+  {
+    const T value = getRandom< T >();
+    size_t maxProducers = std::max< size_t >(4, std::thread::hardware_concurrency());
+    for (size_t producers = 1; producers <= maxProducers; producers *= 2) {
+      ForwardList< T > locked;
+      std::mutex mutex;
+      double lockedTime = measureProducers(producers, size, [&](size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          std::lock_guard< std::mutex > lock(mutex);
+          locked.pushBack(value);
+        }
+      });
+      ConcurrentForwardList< T > lockFree;
+      double lockFreeTime = measureProducers(producers, size, [&](size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          lockFree.pushBack(value);
+        }
+      });
+      out << "pushBack, " << producers << " producers: mutex " << lockedTime << " ms, lock-free " << lockFreeTime;
+      out << " ms\n";
+    }
+    return out;
+  }
+}
+
+#endif
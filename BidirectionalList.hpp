@@ -1,7 +1,10 @@
 #ifndef BIDIRECTIONALLIST_HPP
 #define BIDIRECTIONALLIST_HPP
 #include <cassert>
+#include <functional>
 #include <memory>
+#include <new>
+#include <stdexcept>
 
 namespace gorbunova
 {
@@ -172,6 +175,8 @@ namespace gorbunova
 
     Iterator find(const T& data);
 
+    void compact();
+
     Iterator begin()
     {
       return ConstIterator(head_);
@@ -192,20 +197,24 @@ namespace gorbunova
     Node* head_;
     Node* tail_;
     size_t size_;
+    Node* slab_;
+    size_t slabSize_;
+
+    void release(Node* node) noexcept;
   };
 
   template< typename T >
   BidirectionalList< T >::BidirectionalList():
     head_(nullptr),
     tail_(nullptr),
-    size_(0)
+    size_(0),
+    slab_(nullptr),
+    slabSize_(0)
   {}
 
   template< typename T >
   BidirectionalList< T >::BidirectionalList(const BidirectionalList< T >& rhs):
-    head_(nullptr),
-    tail_(nullptr),
-    size_(0)
+    BidirectionalList()
   {
     Node* tmpHead = rhs.head_;
     while (tmpHead != nullptr)
@@ -219,11 +228,15 @@ namespace gorbunova
   BidirectionalList< T >::BidirectionalList(BidirectionalList< T >&& rhs) noexcept:
     head_(rhs.head_),
     tail_(rhs.tail_),
-    size_(rhs.size_)
+    size_(rhs.size_),
+    slab_(rhs.slab_),
+    slabSize_(rhs.slabSize_)
   {
     rhs.tail_ = nullptr;
     rhs.head_ = nullptr;
-    size_ = 0;
+    rhs.size_ = 0;
+    rhs.slab_ = nullptr;
+    rhs.slabSize_ = 0;
   }
 
   template< typename T >
@@ -260,6 +273,8 @@ namespace gorbunova
     std::swap(head_, rhs.head_);
     std::swap(tail_, rhs.tail_);
     std::swap(size_, rhs.size_);
+    std::swap(slab_, rhs.slab_);
+    std::swap(slabSize_, rhs.slabSize_);
   }
 
   template< typename T >
@@ -269,6 +284,9 @@ namespace gorbunova
     {
       popFront();
     }
+    ::operator delete(slab_);
+    slab_ = nullptr;
+    slabSize_ = 0;
   }
 
   template< typename T >
@@ -376,7 +394,7 @@ namespace gorbunova
     }
     if (!head_->next_)
     {
-      delete head_;
+      release(head_);
       head_ = nullptr;
       tail_ = nullptr;
     }
@@ -384,7 +402,7 @@ namespace gorbunova
     {
       Node* temp = head_;
       head_ = head_->next_;
-      delete temp;
+      release(temp);
       head_->prev_ = nullptr;
     }
     size_--;
@@ -406,7 +424,7 @@ namespace gorbunova
       Node* temp = tail_;
       tail_ = tail_->prev_;
       tail_->next_ = nullptr;
-      delete temp;
+      release(temp);
       size_--;
     }
   }
@@ -436,7 +454,7 @@ namespace gorbunova
         (current->next_)->prev_ = previous;
         previous->next_ = current->next_;
       }
-      delete current;
+      release(current);
       size_--;
     }
   }
@@ -455,6 +473,59 @@ namespace gorbunova
     }
     return iter;;
   }
+
+  template< typename T >
+  void BidirectionalList< T >::release(Node* node) noexcept
+  {
+    std::less< Node* > before;
+    if (slab_ && !before(node, slab_) && before(node, slab_ + slabSize_))
+    {
+      node->~Node();
+    }
+    else
+    {
+      delete node;
+    }
+  }
+
+  template< typename T >
+  void BidirectionalList< T >::compact()
+  {
+    if (size_ == 0)
+    {
+      return;
+    }
+    Node* slab = static_cast< Node* >(::operator new(size_ * sizeof(Node)));
+    size_t count = 0;
+    try
+    {
+      for (Node* node = head_; node != nullptr; node = node->next_, ++count)
+      {
+        Node* copy = new (slab + count) Node(node->data_);
+        if (count != 0)
+        {
+          copy->prev_ = slab + count - 1;
+          copy->prev_->next_ = copy;
+        }
+      }
+    }
+    catch (...)
+    {
+      while (count != 0)
+      {
+        slab[--count].~Node();
+      }
+      ::operator delete(slab);
+      throw;
+    }
+    size_t size = size_;
+    clear();
+    head_ = slab;
+    tail_ = slab + size - 1;
+    size_ = size;
+    slab_ = slab;
+    slabSize_ = size;
+  }
 }
 
 #endif
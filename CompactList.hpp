@@ -0,0 +1,484 @@
+#ifndef COMPACTLIST_HPP
+#define COMPACTLIST_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gorbunova {
+  namespace detail {
+    template< typename T >
+    struct IndexNode {
+      T data_;
+      uint32_t next_;
+      uint32_t prev_;
+    };
+  }
+
+  // Released slots keep their old value until they are reused, so only trivially destructible T are allowed.
+  template< typename T >
+  class CompactList {
+    static_assert(std::is_trivially_destructible_v< T >, "CompactList needs trivially destructible elements");
+
+    public:
+    using Node = detail::IndexNode< T >;
+    static constexpr uint32_t npos = std::numeric_limits< uint32_t >::max();
+
+    class ConstIterator: public std::iterator< std::bidirectional_iterator_tag, T > {
+      public:
+      friend class CompactList;
+
+      ConstIterator():
+        list_(nullptr),
+        index_(npos)
+      {}
+
+      ConstIterator& operator++()
+      {
+        assert(index_ != npos);
+        index_ = list_->nodes_[index_].next_;
+        return *this;
+      }
+
+      ConstIterator operator++(int)
+      {
+        ConstIterator temp(*this);
+        ++(*this);
+        return temp;
+      }
+
+      ConstIterator& operator--()
+      {
+        assert(index_ != npos);
+        index_ = list_->nodes_[index_].prev_;
+        return *this;
+      }
+
+      ConstIterator operator--(int)
+      {
+        ConstIterator temp(*this);
+        --(*this);
+        return temp;
+      }
+
+      bool operator==(const ConstIterator& rhs) const
+      {
+        return index_ == rhs.index_;
+      }
+
+      bool operator!=(const ConstIterator& rhs) const
+      {
+        return !(*this == rhs);
+      }
+
+      const T& operator*() const
+      {
+        assert(index_ != npos);
+        return list_->nodes_[index_].data_;
+      }
+
+      const T* operator->() const
+      {
+        return std::addressof(**this);
+      }
+
+      private:
+      const CompactList* list_;
+      uint32_t index_;
+
+      ConstIterator(const CompactList* list, uint32_t index):
+        list_(list),
+        index_(index)
+      {}
+    };
+
+    class Iterator: public std::iterator< std::bidirectional_iterator_tag, T > {
+      public:
+      friend class CompactList;
+
+      Iterator():
+        iter_()
+      {}
+
+      Iterator(ConstIterator iter):
+        iter_(iter)
+      {}
+
+      Iterator& operator++()
+      {
+        ++iter_;
+        return *this;
+      }
+
+      Iterator operator++(int)
+      {
+        return Iterator(iter_++);
+      }
+
+      Iterator& operator--()
+      {
+        --iter_;
+        return *this;
+      }
+
+      Iterator operator--(int)
+      {
+        return Iterator(iter_--);
+      }
+
+      T& operator*()
+      {
+        return const_cast< T& >(*iter_);
+      }
+
+      T* operator->()
+      {
+        return std::addressof(const_cast< T& >(*iter_));
+      }
+
+      const T& operator*() const
+      {
+        return *iter_;
+      }
+
+      const T* operator->() const
+      {
+        return std::addressof(*iter_);
+      }
+
+      bool operator==(const Iterator& rhs) const
+      {
+        return iter_ == rhs.iter_;
+      }
+
+      bool operator!=(const Iterator& rhs) const
+      {
+        return !(rhs == *this);
+      }
+
+      private:
+      ConstIterator iter_;
+    };
+
+    CompactList();
+    CompactList(const CompactList< T >&);
+    CompactList(CompactList< T >&&) noexcept;
+    ~CompactList() = default;
+
+    CompactList< T >& operator=(const CompactList< T >&);
+    CompactList< T >& operator=(CompactList< T >&&) noexcept;
+
+    void swap(CompactList< T >& rhs) noexcept;
+    void clear() noexcept;
+    void reserve(size_t capacity);
+    T& getFront();
+    T& getBack();
+    size_t getSize() const;
+    size_t getCapacity() const noexcept;
+    bool isEmpty() const noexcept;
+
+    void pushFront(const T& newData);
+    void pushBack(const T& newData);
+    void push(Iterator it, const T& newData);
+
+    void popFront();
+    void popBack();
+    void pop(Iterator it);
+
+    Iterator find(const T& data);
+
+    Iterator begin()
+    {
+      return ConstIterator(this, head_);
+    }
+    Iterator end()
+    {
+      return ConstIterator(this, npos);
+    }
+    ConstIterator begin() const
+    {
+      return ConstIterator(this, head_);
+    }
+    ConstIterator end() const
+    {
+      return ConstIterator(this, npos);
+    }
+
+    private:
+    std::vector< Node > nodes_;
+    uint32_t head_;
+    uint32_t tail_;
+    uint32_t free_;
+    size_t size_;
+
+    uint32_t allocate(const T& data);
+    void release(uint32_t index) noexcept;
+  };
+
+  template< typename T >
+  CompactList< T >::CompactList():
+    head_(npos),
+    tail_(npos),
+    free_(npos),
+    size_(0)
+  {}
+
+  template< typename T >
+  CompactList< T >::CompactList(const CompactList< T >& rhs):
+    CompactList()
+  {
+    reserve(rhs.size_);
+    for (uint32_t i = rhs.head_; i != npos; i = rhs.nodes_[i].next_) {
+      pushBack(rhs.nodes_[i].data_);
+    }
+  }
+
+  template< typename T >
+  CompactList< T >::CompactList(CompactList< T >&& rhs) noexcept:
+    nodes_(std::move(rhs.nodes_)),
+    head_(rhs.head_),
+    tail_(rhs.tail_),
+    free_(rhs.free_),
+    size_(rhs.size_)
+  {
+    rhs.nodes_.clear();
+    rhs.head_ = npos;
+    rhs.tail_ = npos;
+    rhs.free_ = npos;
+    rhs.size_ = 0;
+  }
+
+  template< typename T >
+  CompactList< T >& CompactList< T >::operator=(const CompactList< T >& rhs)
+  {
+    if (this != std::addressof(rhs)) {
+      CompactList< T > temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< typename T >
+  CompactList< T >& CompactList< T >::operator=(CompactList< T >&& rhs) noexcept
+  {
+    if (this != std::addressof(rhs)) {
+      CompactList< T > temp(std::move(rhs));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< typename T >
+  void CompactList< T >::swap(CompactList< T >& rhs) noexcept
+  {
+    nodes_.swap(rhs.nodes_);
+    std::swap(head_, rhs.head_);
+    std::swap(tail_, rhs.tail_);
+    std::swap(free_, rhs.free_);
+    std::swap(size_, rhs.size_);
+  }
+
+  template< typename T >
+  void CompactList< T >::clear() noexcept
+  {
+    nodes_.clear();
+    head_ = npos;
+    tail_ = npos;
+    free_ = npos;
+    size_ = 0;
+  }
+
+  template< typename T >
+  void CompactList< T >::reserve(size_t capacity)
+  {
+    if (capacity >= npos) {
+      throw std::length_error("The list is too large");
+    }
+    nodes_.reserve(capacity);
+  }
+
+  template< typename T >
+  T& CompactList< T >::getFront()
+  {
+    if (size_ == 0) {
+      throw std::logic_error("The list is empty");
+    }
+    return nodes_[head_].data_;
+  }
+
+  template< typename T >
+  T& CompactList< T >::getBack()
+  {
+    if (size_ == 0) {
+      throw std::logic_error("The list is empty");
+    }
+    return nodes_[tail_].data_;
+  }
+
+  template< typename T >
+  size_t CompactList< T >::getSize() const
+  {
+    return size_;
+  }
+
+  template< typename T >
+  size_t CompactList< T >::getCapacity() const noexcept
+  {
+    return nodes_.capacity();
+  }
+
+  template< typename T >
+  bool CompactList< T >::isEmpty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  template< typename T >
+  uint32_t CompactList< T >::allocate(const T& data)
+  {
+    if (free_ != npos) {
+      uint32_t index = free_;
+      free_ = nodes_[index].next_;
+      nodes_[index] = Node{ data, npos, npos };
+      return index;
+    }
+    if (nodes_.size() >= npos) {
+      throw std::length_error("The list is too large");
+    }
+    nodes_.push_back(Node{ data, npos, npos });
+    return static_cast< uint32_t >(nodes_.size() - 1);
+  }
+
+  template< typename T >
+  void CompactList< T >::release(uint32_t index) noexcept
+  {
+    nodes_[index].next_ = free_;
+    nodes_[index].prev_ = npos;
+    free_ = index;
+  }
+
+  template< typename T >
+  void CompactList< T >::pushFront(const T& newData)
+  {
+    uint32_t index = allocate(newData);
+    nodes_[index].next_ = head_;
+    if (head_ == npos) {
+      tail_ = index;
+    } else {
+      nodes_[head_].prev_ = index;
+    }
+    head_ = index;
+    size_++;
+  }
+
+  template< typename T >
+  void CompactList< T >::pushBack(const T& newData)
+  {
+    uint32_t index = allocate(newData);
+    nodes_[index].prev_ = tail_;
+    if (tail_ == npos) {
+      head_ = index;
+    } else {
+      nodes_[tail_].next_ = index;
+    }
+    tail_ = index;
+    size_++;
+  }
+
+  template< typename T >
+  void CompactList< T >::push(Iterator it, const T& data)
+  {
+    if (it == begin()) {
+      pushFront(data);
+    } else if (it == end()) {
+      pushBack(data);
+    } else {
+      uint32_t current = it.iter_.index_;
+      uint32_t index = allocate(data);
+      uint32_t previous = nodes_[current].prev_;
+      nodes_[index].prev_ = previous;
+      nodes_[index].next_ = current;
+      nodes_[previous].next_ = index;
+      nodes_[current].prev_ = index;
+      size_++;
+    }
+  }
+
+  template< typename T >
+  void CompactList< T >::popFront()
+  {
+    if (isEmpty()) {
+      throw std::logic_error("The list is empty");
+    }
+    uint32_t index = head_;
+    head_ = nodes_[index].next_;
+    if (head_ == npos) {
+      tail_ = npos;
+    } else {
+      nodes_[head_].prev_ = npos;
+    }
+    release(index);
+    size_--;
+  }
+
+  template< typename T >
+  void CompactList< T >::popBack()
+  {
+    if (isEmpty()) {
+      throw std::logic_error("The list is empty");
+    }
+    uint32_t index = tail_;
+    tail_ = nodes_[index].prev_;
+    if (tail_ == npos) {
+      head_ = npos;
+    } else {
+      nodes_[tail_].next_ = npos;
+    }
+    release(index);
+    size_--;
+  }
+
+  template< typename T >
+  void CompactList< T >::pop(Iterator it)
+  {
+    if (isEmpty()) {
+      throw std::logic_error("The list is empty");
+    }
+    uint32_t index = it.iter_.index_;
+    if (index == npos) {
+      throw std::logic_error("Invalid iterator");
+    }
+    if (index == head_) {
+      popFront();
+    } else if (index == tail_) {
+      popBack();
+    } else {
+      uint32_t previous = nodes_[index].prev_;
+      uint32_t next = nodes_[index].next_;
+      nodes_[previous].next_ = next;
+      nodes_[next].prev_ = previous;
+      release(index);
+      size_--;
+    }
+  }
+
+  template< typename T >
+  typename CompactList< T >::Iterator CompactList< T >::find(const T& data)
+  {
+    auto iter = begin();
+    while (iter != end()) {
+      if (*iter == data) {
+        return iter;
+      }
+      ++iter;
+    }
+    return iter;
+  }
+}
+
+#endif
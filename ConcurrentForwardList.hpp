@@ -0,0 +1,192 @@
+#ifndef CONCURRENTFORWARDLIST_HPP
+#define CONCURRENTFORWARDLIST_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include "ForwardList.hpp"
+#include "HazardPointers.hpp"
+#include "ListNode.hpp"
+
+namespace gorbunova {
+  // pushFront and popFront form a lock-free stack and may be used from any thread.
+  // pushBack is wait-free for any number of producers, but once it is in use popFront
+  // must be called from a single consumer. detach expects the list to be quiescent; it splices
+  // the pushBack segment in O(1) but walks the pushFront segment once to find its last node.
+  // Element counts are kept per thread, so getSize is only exact while the list is quiescent.
+  // Needs C++20 for std::atomic_ref on the plain ForwardList links.
+  template< typename T >
+  class ConcurrentForwardList {
+    struct alignas(64) Counter {
+      std::atomic< std::ptrdiff_t > value{ 0 };
+    };
+
+    public:
+    static constexpr size_t countersCount = 16;
+
+    using Node = ListNode< T >;
+
+    ConcurrentForwardList();
+    ConcurrentForwardList(const ConcurrentForwardList< T >&) = delete;
+    ~ConcurrentForwardList();
+    ConcurrentForwardList< T >& operator=(const ConcurrentForwardList< T >&) = delete;
+
+    size_t getSize() const noexcept;
+    bool isEmpty() const noexcept;
+    void pushFront(const T& newData);
+    void pushBack(const T& newData);
+    bool popFront(T& data);
+    ForwardList< T > detach();
+
+    private:
+    alignas(64) std::atomic< Node* > head_;
+    alignas(64) std::atomic< Node* > backHead_;
+    alignas(64) std::atomic< Node* > backTail_;
+    std::array< Counter, countersCount > counters_;
+    HazardPointers hazards_;
+
+    bool popBackSegment(T& data);
+    void count(std::ptrdiff_t delta) noexcept;
+
+    static std::atomic_ref< Node* > link(Node* node)
+    {
+      return std::atomic_ref< Node* >(node->next_);
+    }
+  };
+
+  template< typename T >
+  ConcurrentForwardList< T >::ConcurrentForwardList():
+    head_(nullptr),
+    backHead_(nullptr),
+    backTail_(nullptr)
+  {}
+
+  template< typename T >
+  ConcurrentForwardList< T >::~ConcurrentForwardList()
+  {
+    detach();
+  }
+
+  template< typename T >
+  size_t ConcurrentForwardList< T >::getSize() const noexcept
+  {
+    std::ptrdiff_t size = 0;
+    for (const Counter& counter : counters_) {
+      size += counter.value.load(std::memory_order_relaxed);
+    }
+    return size > 0 ? static_cast< size_t >(size) : 0;
+  }
+
+  template< typename T >
+  bool ConcurrentForwardList< T >::isEmpty() const noexcept
+  {
+    return !head_.load(std::memory_order_acquire) && !backTail_.load(std::memory_order_acquire);
+  }
+
+  // Each thread keeps adding to the counter it was first given, so producers do not share a cache line
+  // unless there are more of them than counters.
+  template< typename T >
+  void ConcurrentForwardList< T >::count(std::ptrdiff_t delta) noexcept
+  {
+    static std::atomic< size_t > threads{ 0 };
+    thread_local size_t index = threads.fetch_add(1, std::memory_order_relaxed) % countersCount;
+    counters_[index].value.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  template< typename T >
+  void ConcurrentForwardList< T >::pushFront(const T& newData)
+  {
+    Node* newNode = new Node(newData);
+    count(1);
+    Node* top = head_.load(std::memory_order_relaxed);
+    do {
+      newNode->next_ = top;
+    } while (!head_.compare_exchange_weak(top, newNode, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  template< typename T >
+  void ConcurrentForwardList< T >::pushBack(const T& newData)
+  {
+    Node* newNode = new Node(newData);
+    count(1);
+    Node* previous = backTail_.exchange(newNode, std::memory_order_acq_rel);
+    if (previous) {
+      link(previous).store(newNode, std::memory_order_release);
+    } else {
+      backHead_.store(newNode, std::memory_order_release);
+    }
+  }
+
+  template< typename T >
+  bool ConcurrentForwardList< T >::popFront(T& data)
+  {
+    {
+      HazardPointers::Guard guard(hazards_);
+      Node* top = guard.protect(head_);
+      while (top) {
+        Node* next = top->next_;
+        if (head_.compare_exchange_strong(top, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+          guard.reset();
+          data = std::move(top->data_);
+          hazards_.retire(top);
+          count(-1);
+          return true;
+        }
+        top = guard.protect(head_);
+      }
+    }
+    return popBackSegment(data);
+  }
+
+  template< typename T >
+  bool ConcurrentForwardList< T >::popBackSegment(T& data)
+  {
+    Node* first = backHead_.load(std::memory_order_acquire);
+    if (!first) {
+      return false;
+    }
+    Node* next = link(first).load(std::memory_order_acquire);
+    if (next) {
+      backHead_.store(next, std::memory_order_release);
+    } else {
+      Node* expected = first;
+      if (backTail_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+        expected = first;
+        backHead_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+      } else {
+        while (!(next = link(first).load(std::memory_order_acquire))) {
+          std::this_thread::yield();
+        }
+        backHead_.store(next, std::memory_order_release);
+      }
+    }
+    data = std::move(first->data_);
+    delete first;
+    count(-1);
+    return true;
+  }
+
+  template< typename T >
+  ForwardList< T > ConcurrentForwardList< T >::detach()
+  {
+    Node* front = head_.exchange(nullptr, std::memory_order_acquire);
+    Node* back = backHead_.exchange(nullptr, std::memory_order_acquire);
+    Node* tail = backTail_.exchange(nullptr, std::memory_order_acquire);
+    std::ptrdiff_t size = 0;
+    for (Counter& counter : counters_) {
+      size += counter.value.exchange(0, std::memory_order_relaxed);
+    }
+    if (!front) {
+      return ForwardList< T >(back, tail, static_cast< size_t >(size));
+    }
+    Node* last = front;
+    while (last->next_) {
+      last = last->next_;
+    }
+    last->next_ = back;
+    return ForwardList< T >(front, tail ? tail : last, static_cast< size_t >(size));
+  }
+}
+
+#endif
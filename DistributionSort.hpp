@@ -0,0 +1,132 @@
+#ifndef DISTRIBUTIONSORT_HPP
+#define DISTRIBUTIONSORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "MergeSort.hpp"
+#include "QuickSort.hpp"
+#include "Verify.hpp"
+
+namespace {
+  constexpr size_t distributionBaseCase = 4096;
+  constexpr size_t maxTreeLevels = 8;
+  constexpr size_t distributionOversampling = 4;
+  constexpr size_t distributionMaxDepth = 8;
+  constexpr size_t classifyUnroll = 4;
+
+  template< typename T >
+  void buildSplitterTree(const std::vector< T >& splitters, std::vector< T >& tree, size_t node, size_t low, size_t high)
+  {
+    size_t middle = (low + high) / 2;
+    tree[node] = splitters[middle];
+    if (2 * node < tree.size()) {
+      buildSplitterTree(splitters, tree, 2 * node, low, middle);
+      buildSplitterTree(splitters, tree, 2 * node + 1, middle + 1, high);
+    }
+  }
+
+  template< typename T, typename Compare >
+  size_t equalityBucket(size_t leaf, size_t leaves, const T& value, const std::vector< T >& splitters, Compare& cmp)
+  {
+    return 2 * leaf + ((leaf + 1 < leaves) & !cmp(value, splitters[leaf]));
+  }
+
+  // Leaf b of the tree holds splitters[b - 1] < x <= splitters[b]; bucket 2b gets the keys strictly between
+  // the splitters and bucket 2b + 1 the keys equal to splitters[b], which need no further sorting.
+  template< typename T, typename Compare >
+  void distributionSortBuffer(T* data, T* scratch, size_t size, Compare& cmp, size_t depth)
+  {
+    if (size <= distributionBaseCase || depth == distributionMaxDepth) {
+      gorbunova::quickSort(data, data + size, cmp);
+      return;
+    }
+    size_t levels = 1;
+    while (levels < maxTreeLevels && (size_t(64) << levels) < size) {
+      ++levels;
+    }
+    size_t leaves = size_t(1) << levels;
+
+    std::vector< T > sample;
+    for (size_t i = 0; i < distributionOversampling * leaves; ++i) {
+      sample.push_back(data[mixHash(i + size * depth) % size]);
+    }
+    gorbunova::mergeSort(sample.begin(), sample.end(), cmp);
+    std::vector< T > splitters;
+    for (size_t i = 1; i < leaves; ++i) {
+      splitters.push_back(sample[i * sample.size() / leaves]);
+    }
+    std::vector< T > tree(leaves);
+    buildSplitterTree(splitters, tree, 1, 0, splitters.size());
+    splitters.push_back(splitters.back());
+
+    std::vector< uint16_t > oracle(size);
+    std::vector< size_t > counts(2 * leaves + 1);
+    size_t i = 0;
+    for (; i + classifyUnroll <= size; i += classifyUnroll) {
+      size_t nodes[classifyUnroll];
+      for (size_t k = 0; k < classifyUnroll; ++k) {
+        nodes[k] = 1;
+      }
+      for (size_t level = 0; level < levels; ++level) {
+        for (size_t k = 0; k < classifyUnroll; ++k) {
+          nodes[k] = 2 * nodes[k] + cmp(tree[nodes[k]], data[i + k]);
+        }
+      }
+      for (size_t k = 0; k < classifyUnroll; ++k) {
+        oracle[i + k] = static_cast< uint16_t >(equalityBucket(nodes[k] - leaves, leaves, data[i + k], splitters, cmp));
+        ++counts[oracle[i + k] + 1];
+      }
+    }
+    for (; i < size; ++i) {
+      size_t node = 1;
+      for (size_t level = 0; level < levels; ++level) {
+        node = 2 * node + cmp(tree[node], data[i]);
+      }
+      oracle[i] = static_cast< uint16_t >(equalityBucket(node - leaves, leaves, data[i], splitters, cmp));
+      ++counts[oracle[i] + 1];
+    }
+    for (size_t bucket = 1; bucket < counts.size(); ++bucket) {
+      counts[bucket] += counts[bucket - 1];
+    }
+    std::vector< size_t > offsets(counts.begin(), counts.end() - 1);
+    for (i = 0; i < size; ++i) {
+      scratch[offsets[oracle[i]]++] = data[i];
+    }
+    std::copy(scratch, scratch + size, data);
+    for (size_t bucket = 0; bucket < 2 * leaves; bucket += 2) {
+      size_t length = counts[bucket + 1] - counts[bucket];
+      if (length > 1) {
+        distributionSortBuffer(data + counts[bucket], scratch, length, cmp, depth + 1);
+      }
+    }
+  }
+}
+
+namespace gorbunova {
+  // Sample sort for arithmetic keys: splitters drawn from a random sample form an implicit search tree that
+  // classifies every element without data-dependent branches, the elements are scattered into their buckets
+  // in one pass, and buckets that fit in cache are finished with quickSort. Works on any forward range;
+  // the elements are gathered into a buffer and written back once.
+  template< typename Iter, typename Compare >
+  void distributionSort(Iter first, Iter last, Compare cmp)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    static_assert(std::is_arithmetic_v< value >, "distributionSort needs arithmetic elements");
+    std::vector< value > data;
+    for (Iter it = first; it != last; ++it) {
+      data.push_back(*it);
+    }
+    std::vector< value > scratch(data.size());
+    distributionSortBuffer(data.data(), scratch.data(), data.size(), cmp, 0);
+    auto it = data.begin();
+    for (Iter current = first; current != last; ++current, ++it) {
+      *current = *it;
+    }
+  }
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <cassert>
+#include <functional>
+#include <new>
 #include <stdexcept>
 #include "ListNode.hpp"
 
@@ -96,6 +98,7 @@ namespace gorbunova {
     void pushAfter(Iterator it, const T& newData);
     void popFront();
     void pop(Iterator it);
+    void compact();
     Iterator begin()
     {
       return Iterator(head_);
@@ -106,23 +109,26 @@ namespace gorbunova {
     }
 
     private:
+    template< typename > friend class ConcurrentForwardList;
+
     Node* head_;
     Node* tail_;
     size_t size_;
+    Node* slab_;
+    size_t slabSize_;
+
+    ForwardList(Node* head, Node* tail, size_t size);
+    void release(Node* node) noexcept;
   };
 
   template< typename T >
   ForwardList< T >::ForwardList():
-    head_(nullptr),
-    tail_(nullptr),
-    size_(0)
+    ForwardList(nullptr, nullptr, 0)
   {}
 
   template< typename T >
   ForwardList< T >::ForwardList(const ForwardList< T >& rhs):
-    head_(nullptr),
-    tail_(nullptr),
-    size_(0)
+    ForwardList()
   {
     Node* tmp_head = rhs.head_;
     while (tmp_head != nullptr) {
@@ -135,13 +141,26 @@ namespace gorbunova {
   ForwardList< T >::ForwardList(ForwardList< T >&& rhs) noexcept:
     head_(rhs.head_),
     tail_(rhs.tail_),
-    size_(rhs.size_)
+    size_(rhs.size_),
+    slab_(rhs.slab_),
+    slabSize_(rhs.slabSize_)
   {
     rhs.tail_ = nullptr;
     rhs.head_ = nullptr;
-    size_ = 0;
+    rhs.size_ = 0;
+    rhs.slab_ = nullptr;
+    rhs.slabSize_ = 0;
   }
 
+  template< typename T >
+  ForwardList< T >::ForwardList(Node* head, Node* tail, size_t size):
+    head_(head),
+    tail_(tail),
+    size_(size),
+    slab_(nullptr),
+    slabSize_(0)
+  {}
+
   template< typename T >
   ForwardList< T >::~ForwardList()
   {
@@ -174,6 +193,8 @@ namespace gorbunova {
     std::swap(head_, rhs.head_);
     std::swap(tail_, rhs.tail_);
     std::swap(size_, rhs.size_);
+    std::swap(slab_, rhs.slab_);
+    std::swap(slabSize_, rhs.slabSize_);
   }
 
 
@@ -183,6 +204,9 @@ namespace gorbunova {
     while (size_ != 0) {
       popFront();
     }
+    ::operator delete(slab_);
+    slab_ = nullptr;
+    slabSize_ = 0;
   }
 
   template< typename T >
@@ -265,13 +289,13 @@ namespace gorbunova {
       throw std::logic_error("The list is empty");
     }
     if (!head_->next_) {
-      delete head_;
+      release(head_);
       head_ = nullptr;
       tail_ = nullptr;
     } else {
       Node* temp = head_;
       head_ = head_->next_;
-      delete temp;
+      release(temp);
     }
     size_--;
   }
@@ -292,10 +316,52 @@ namespace gorbunova {
       }
       Node* rem = prev->next_;
       prev->next_ = rem->next_;
-      delete rem;
+      release(rem);
       size_--;
     }
   }
+
+  template< typename T >
+  void ForwardList< T >::release(Node* node) noexcept
+  {
+    std::less< Node* > before;
+    if (slab_ && !before(node, slab_) && before(node, slab_ + slabSize_)) {
+      node->~Node();
+    } else {
+      delete node;
+    }
+  }
+
+  template< typename T >
+  void ForwardList< T >::compact()
+  {
+    if (size_ == 0) {
+      return;
+    }
+    Node* slab = static_cast< Node* >(::operator new(size_ * sizeof(Node)));
+    size_t count = 0;
+    try {
+      for (Node* node = head_; node != nullptr; node = node->next_, ++count) {
+        Node* copy = new (slab + count) Node(node->data_);
+        if (count != 0) {
+          slab[count - 1].next_ = copy;
+        }
+      }
+    } catch (...) {
+      while (count != 0) {
+        slab[--count].~Node();
+      }
+      ::operator delete(slab);
+      throw;
+    }
+    size_t size = size_;
+    clear();
+    head_ = slab;
+    tail_ = slab + size - 1;
+    size_ = size;
+    slab_ = slab;
+    slabSize_ = size;
+  }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace gorbunova {
+  // Single-pass coroutine that yields references to T; a yielded value is valid until the next resume.
+  template< typename T >
+  class Generator {
+    public:
+    struct promise_type {
+      const T* value_ = nullptr;
+      std::exception_ptr exception_;
+
+      Generator get_return_object()
+      {
+        return Generator(std::coroutine_handle< promise_type >::from_promise(*this));
+      }
+
+      std::suspend_always initial_suspend() noexcept
+      {
+        return {};
+      }
+
+      std::suspend_always final_suspend() noexcept
+      {
+        return {};
+      }
+
+      std::suspend_always yield_value(const T& value) noexcept
+      {
+        value_ = std::addressof(value);
+        return {};
+      }
+
+      void return_void() noexcept
+      {}
+
+      void unhandled_exception()
+      {
+        exception_ = std::current_exception();
+      }
+    };
+
+    class Iterator {
+      public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const T*;
+      using reference = const T&;
+
+      Iterator():
+        coroutine_(nullptr)
+      {}
+
+      Iterator& operator++()
+      {
+        resume(coroutine_);
+        return *this;
+      }
+
+      void operator++(int)
+      {
+        ++*this;
+      }
+
+      const T& operator*() const
+      {
+        return *coroutine_.promise().value_;
+      }
+
+      const T* operator->() const
+      {
+        return coroutine_.promise().value_;
+      }
+
+      bool operator==(std::default_sentinel_t) const
+      {
+        return !coroutine_ || coroutine_.done();
+      }
+
+      private:
+      friend class Generator< T >;
+      std::coroutine_handle< promise_type > coroutine_;
+
+      explicit Iterator(std::coroutine_handle< promise_type > coroutine):
+        coroutine_(coroutine)
+      {}
+    };
+
+    Generator(const Generator< T >&) = delete;
+    Generator(Generator< T >&& rhs) noexcept:
+      coroutine_(std::exchange(rhs.coroutine_, nullptr)),
+      started_(std::exchange(rhs.started_, false))
+    {}
+
+    ~Generator()
+    {
+      if (coroutine_) {
+        coroutine_.destroy();
+      }
+    }
+
+    Generator< T >& operator=(const Generator< T >&) = delete;
+    Generator< T >& operator=(Generator< T >&& rhs) noexcept
+    {
+      std::swap(coroutine_, rhs.coroutine_);
+      std::swap(started_, rhs.started_);
+      return *this;
+    }
+
+    Iterator begin()
+    {
+      if (coroutine_ && !started_) {
+        started_ = true;
+        resume(coroutine_);
+      }
+      return Iterator(coroutine_);
+    }
+
+    std::default_sentinel_t end() const noexcept
+    {
+      return std::default_sentinel;
+    }
+
+    private:
+    std::coroutine_handle< promise_type > coroutine_;
+    bool started_;
+
+    explicit Generator(std::coroutine_handle< promise_type > coroutine):
+      coroutine_(coroutine),
+      started_(false)
+    {}
+
+    static void resume(std::coroutine_handle< promise_type > coroutine)
+    {
+      coroutine.resume();
+      if (coroutine.promise().exception_) {
+        std::rethrow_exception(coroutine.promise().exception_);
+      }
+    }
+  };
+
+  template< typename T >
+  Generator< T > take(Generator< T > source, size_t count)
+  {
+    if (count == 0) {
+      co_return;
+    }
+    for (const T& value : source) {
+      co_yield value;
+      if (--count == 0) {
+        co_return;
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef HAZARD_POINTERS_HPP
+#define HAZARD_POINTERS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace gorbunova {
+  class HazardPointers {
+    struct alignas(64) Slot {
+      std::atomic< bool > active{ false };
+      std::atomic< void* > pointer{ nullptr };
+    };
+
+    public:
+    static constexpr size_t slotsCount = 128;
+    static constexpr size_t scanThreshold = 2 * slotsCount;
+
+    class Guard {
+      public:
+      explicit Guard(HazardPointers& domain):
+        slot_(domain.acquire())
+      {}
+
+      Guard(const Guard&) = delete;
+      Guard& operator=(const Guard&) = delete;
+
+      ~Guard()
+      {
+        reset();
+        slot_->active.store(false, std::memory_order_release);
+      }
+
+      template< typename Node >
+      Node* protect(const std::atomic< Node* >& source)
+      {
+        Node* pointer = source.load(std::memory_order_relaxed);
+        while (true) {
+          slot_->pointer.store(pointer, std::memory_order_seq_cst);
+          Node* current = source.load(std::memory_order_seq_cst);
+          if (current == pointer) {
+            return pointer;
+          }
+          pointer = current;
+        }
+      }
+
+      void reset() noexcept
+      {
+        slot_->pointer.store(nullptr, std::memory_order_release);
+      }
+
+      private:
+      Slot* slot_;
+    };
+
+    HazardPointers():
+      retired_(nullptr),
+      retiredCount_(0)
+    {}
+
+    HazardPointers(const HazardPointers&) = delete;
+    HazardPointers& operator=(const HazardPointers&) = delete;
+
+    ~HazardPointers()
+    {
+      Retired* retired = retired_.load(std::memory_order_acquire);
+      while (retired) {
+        Retired* next = retired->next;
+        retired->deleter(retired->pointer);
+        delete retired;
+        retired = next;
+      }
+    }
+
+    template< typename Node >
+    void retire(Node* node)
+    {
+      Retired* retired = new Retired{ node, &destroy< Node >, nullptr };
+      push(retired, retired);
+      if (retiredCount_.fetch_add(1, std::memory_order_relaxed) + 1 >= scanThreshold) {
+        scan();
+      }
+    }
+
+    private:
+    struct Retired {
+      void* pointer;
+      void (*deleter)(void*);
+      Retired* next;
+    };
+
+    std::array< Slot, slotsCount > slots_;
+    std::atomic< Retired* > retired_;
+    std::atomic< size_t > retiredCount_;
+
+    template< typename Node >
+    static void destroy(void* pointer)
+    {
+      delete static_cast< Node* >(pointer);
+    }
+
+    Slot* acquire()
+    {
+      static thread_local size_t hint = std::hash< std::thread::id >()(std::this_thread::get_id());
+      while (true) {
+        for (size_t i = 0; i < slotsCount; ++i) {
+          Slot& slot = slots_[(hint + i) % slotsCount];
+          bool expected = false;
+          if (!slot.active.load(std::memory_order_relaxed)
+              && slot.active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            hint = (hint + i) % slotsCount;
+            return std::addressof(slot);
+          }
+        }
+        std::this_thread::yield();
+      }
+    }
+
+    void push(Retired* first, Retired* last)
+    {
+      Retired* head = retired_.load(std::memory_order_relaxed);
+      do {
+        last->next = head;
+      } while (!retired_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void scan()
+    {
+      Retired* retired = retired_.exchange(nullptr, std::memory_order_acquire);
+      std::vector< void* > hazards;
+      for (const Slot& slot : slots_) {
+        if (void* pointer = slot.pointer.load(std::memory_order_seq_cst)) {
+          hazards.push_back(pointer);
+        }
+      }
+      std::sort(hazards.begin(), hazards.end());
+      Retired* keptFirst = nullptr;
+      Retired* keptLast = nullptr;
+      size_t released = 0;
+      while (retired) {
+        Retired* next = retired->next;
+        if (std::binary_search(hazards.begin(), hazards.end(), retired->pointer)) {
+          retired->next = keptFirst;
+          keptFirst = retired;
+          if (!keptLast) {
+            keptLast = retired;
+          }
+        } else {
+          retired->deleter(retired->pointer);
+          delete retired;
+          ++released;
+        }
+        retired = next;
+      }
+      retiredCount_.fetch_sub(released, std::memory_order_relaxed);
+      if (keptFirst) {
+        push(keptFirst, keptLast);
+      }
+    }
+  };
+}
+#endif
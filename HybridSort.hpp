@@ -0,0 +1,46 @@
+#ifndef HYBRIDSORT_HPP
+#define HYBRIDSORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace gorbunova {
+  constexpr size_t stagingThreshold = 64;
+
+  template< typename Iter >
+  constexpr bool isStageable = !std::is_base_of_v< std::random_access_iterator_tag,
+      typename std::iterator_traits< Iter >::iterator_category >
+    && std::is_trivially_copyable_v< typename std::iterator_traits< Iter >::value_type >;
+
+  template< typename Iter, typename Compare, typename Sorter >
+  void stagedSort(Iter first, Iter last, Compare cmp, Sorter sorter)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    std::vector< value > buffer;
+    for (Iter it = first; it != last; ++it) {
+      buffer.push_back(*it);
+    }
+    sorter(buffer.begin(), buffer.end(), cmp);
+    auto bit = buffer.begin();
+    for (Iter it = first; it != last; ++it, ++bit) {
+      *it = *bit;
+    }
+  }
+
+  template< typename Iter, typename Compare, typename Sorter >
+  void hybridSort(Iter first, Iter last, Compare cmp, Sorter sorter, size_t threshold = stagingThreshold)
+  {
+    if constexpr (isStageable< Iter >) {
+      if (static_cast< size_t >(std::distance(first, last)) >= threshold) {
+        stagedSort(first, last, cmp, sorter);
+        return;
+      }
+    }
+    sorter(first, last, cmp);
+  }
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef INDIRECTSORT_HPP
+#define INDIRECTSORT_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+  template< typename Key >
+  struct IndirectEntry {
+    Key key;
+    size_t index;
+  };
+
+  template< typename T >
+  using ElementKey = std::conditional_t< std::is_trivially_copyable_v< T > && sizeof(T) <= sizeof(void*), T, const T* >;
+
+  template< typename T >
+  const T& elementOf(const T& key)
+  {
+    return key;
+  }
+
+  template< typename T >
+  const T& elementOf(const T* key)
+  {
+    return *key;
+  }
+
+  template< typename Iter >
+  void applyPermutation(Iter first, std::vector< size_t >& order)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    std::vector< Iter > positions;
+    positions.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i, ++first) {
+      positions.push_back(first);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (order[i] == i) {
+        continue;
+      }
+      value hold = std::move(*positions[i]);
+      size_t j = i;
+      while (order[j] != i) {
+        size_t next = order[j];
+        *positions[j] = std::move(*positions[next]);
+        order[j] = j;
+        j = next;
+      }
+      *positions[j] = std::move(hold);
+      order[j] = j;
+    }
+  }
+
+  template< typename Iter, typename Key, typename Compare, typename Sorter >
+  void sortEntries(Iter first, std::vector< IndirectEntry< Key > >& entries, Compare cmp, Sorter sorter)
+  {
+    if (entries.size() < 2) {
+      return;
+    }
+    sorter(entries.begin(), entries.end(), [&cmp](const IndirectEntry< Key >& lhs, const IndirectEntry< Key >& rhs) {
+      return cmp(lhs.key, rhs.key);
+    });
+    std::vector< size_t > order;
+    order.reserve(entries.size());
+    for (const IndirectEntry< Key >& entry : entries) {
+      order.push_back(entry.index);
+    }
+    entries = std::vector< IndirectEntry< Key > >();
+    applyPermutation(first, order);
+  }
+}
+
+namespace gorbunova {
+  // Sorts (key, index) entries with the given sorter, then moves every element into place once.
+  // cmp compares the keys produced by key, which is called exactly once per element.
+  template< typename Iter, typename Compare, typename Sorter, typename KeyOf >
+  void indirectSort(Iter first, Iter last, Compare cmp, Sorter sorter, KeyOf key)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    using Key = std::decay_t< std::invoke_result_t< KeyOf&, const value& > >;
+    std::vector< IndirectEntry< Key > > entries;
+    size_t index = 0;
+    for (Iter it = first; it != last; ++it) {
+      entries.push_back(IndirectEntry< Key >{ key(*it), index++ });
+    }
+    sortEntries(first, entries, cmp, sorter);
+  }
+
+  // Small trivially copyable elements are cached as keys, anything else is compared through a pointer.
+  template< typename Iter, typename Compare, typename Sorter >
+  void indirectSort(Iter first, Iter last, Compare cmp, Sorter sorter)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    using Key = ElementKey< value >;
+    std::vector< IndirectEntry< Key > > entries;
+    size_t index = 0;
+    for (Iter it = first; it != last; ++it) {
+      if constexpr (std::is_pointer_v< Key >) {
+        entries.push_back(IndirectEntry< Key >{ std::addressof(*it), index++ });
+      } else {
+        entries.push_back(IndirectEntry< Key >{ *it, index++ });
+      }
+    }
+    sortEntries(first, entries, [&cmp](const Key& lhs, const Key& rhs) {
+      return cmp(elementOf< value >(lhs), elementOf< value >(rhs));
+    }, sorter);
+  }
+}
+
+#endif
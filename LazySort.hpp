@@ -0,0 +1,97 @@
+#ifndef LAZYSORT_HPP
+#define LAZYSORT_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Generator.hpp"
+
+namespace {
+  constexpr size_t lazyInsertionThreshold = 16;
+
+  template< typename T, typename Compare >
+  void insertionSortKeys(const T** keys, size_t size, Compare& cmp)
+  {
+    for (size_t i = 1; i < size; ++i) {
+      const T* key = keys[i];
+      size_t j = i;
+      for (; j > 0 && cmp(*key, *keys[j - 1]); --j) {
+        keys[j] = keys[j - 1];
+      }
+      keys[j] = key;
+    }
+  }
+
+  // Three-way partition of keys[first, last) around the median of three; returns the bounds of the equal run.
+  template< typename T, typename Compare >
+  std::pair< size_t, size_t > partitionKeys(const T** keys, size_t first, size_t last, Compare& cmp)
+  {
+    const T* a = keys[first];
+    const T* b = keys[first + (last - first) / 2];
+    const T* c = keys[last - 1];
+    if (cmp(*b, *a)) {
+      std::swap(a, b);
+    }
+    if (cmp(*c, *b)) {
+      b = cmp(*c, *a) ? a : c;
+    }
+    const T* pivot = b;
+    size_t less = first;
+    size_t i = first;
+    size_t greater = last;
+    while (i < greater) {
+      if (cmp(*keys[i], *pivot)) {
+        std::swap(keys[less++], keys[i++]);
+      } else if (cmp(*pivot, *keys[i])) {
+        std::swap(keys[i], keys[--greater]);
+      } else {
+        ++i;
+      }
+    }
+    return { less, greater };
+  }
+}
+
+namespace gorbunova {
+  // Incremental quicksort over pointers to the elements: each step partitions only the leftmost unsorted
+  // range until its smallest element is known, so the first element costs O(n) and reading k elements
+  // costs O(n + k log k). The container is left untouched and must outlive the generator.
+  template< typename Iter, typename Compare >
+  Generator< typename std::iterator_traits< Iter >::value_type > sortedView(Iter first, Iter last, Compare cmp)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    std::vector< const value* > keys;
+    for (Iter it = first; it != last; ++it) {
+      keys.push_back(std::addressof(*it));
+    }
+    std::vector< size_t > bounds{ keys.size() };
+    size_t next = 0;
+    while (next < keys.size()) {
+      size_t bound = bounds.back();
+      if (next == bound) {
+        bounds.pop_back();
+      } else if (bound - next <= lazyInsertionThreshold) {
+        insertionSortKeys(keys.data() + next, bound - next, cmp);
+        for (; next < bound; ++next) {
+          co_yield *keys[next];
+        }
+      } else {
+        std::pair< size_t, size_t > equal = partitionKeys(keys.data(), next, bound, cmp);
+        if (equal.first == next) {
+          for (; next < equal.second; ++next) {
+            co_yield *keys[next];
+          }
+        } else {
+          if (equal.second < bound) {
+            bounds.push_back(equal.second);
+          }
+          bounds.push_back(equal.first);
+        }
+      }
+    }
+  }
+}
+
+#endif
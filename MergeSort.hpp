@@ -1,14 +1,19 @@
 #ifndef MERGESORT_HPP
 #define MERGESORT_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <type_traits>
+#include <vector>
 #include "BidirectionalList.hpp"
+#include "SegmentedSort.hpp"
 
 namespace {
   template< typename Iter, typename Compare >
   void merge(Iter first, Iter mid, Iter last, Compare cmp)
   {
-    using value = typename Iter::value_type;
+    using value = typename std::iterator_traits< Iter >::value_type;
     Iter it1 = first;
     Iter it2 = mid;
     gorbunova::BidirectionalList< value > arr;
@@ -37,6 +42,160 @@ namespace {
       *it = *bit;
     }
   }
+
+  template< typename Iter, typename Compare >
+  void mergeSortRange(Iter first, Iter last, Compare cmp)
+  {
+    if (first == last || std::next(first) == last) {
+      return;
+    }
+
+    Iter mid = std::next(first, std::distance(first, last) / 2);
+    mergeSortRange(first, mid, cmp);
+    mergeSortRange(mid, last, cmp);
+    merge(first, mid, last, cmp);
+  }
+
+  constexpr size_t boundedInsertionThreshold = 16;
+
+  // std::rotate steps bidirectional iterators back from last, which the list end() iterators do not support.
+  template< typename Iter >
+  Iter rotateRange(Iter first, Iter middle, Iter last)
+  {
+    if constexpr (std::is_base_of_v< std::random_access_iterator_tag,
+        typename std::iterator_traits< Iter >::iterator_category >) {
+      return std::rotate(first, middle, last);
+    } else {
+      if (first == middle) {
+        return last;
+      }
+      if (middle == last) {
+        return first;
+      }
+      Iter next = middle;
+      do {
+        std::iter_swap(first++, next++);
+        if (first == middle) {
+          middle = next;
+        }
+      } while (next != last);
+      Iter result = first;
+      next = middle;
+      while (next != last) {
+        std::iter_swap(first++, next++);
+        if (first == middle) {
+          middle = next;
+        } else if (next == last) {
+          next = middle;
+        }
+      }
+      return result;
+    }
+  }
+
+  template< typename Iter, typename Compare >
+  void insertionSortStable(Iter first, Iter last, Compare& cmp)
+  {
+    if (first == last) {
+      return;
+    }
+    for (Iter it = std::next(first); it != last; ++it) {
+      Iter position = std::upper_bound(first, it, *it, cmp);
+      if (position != it) {
+        rotateRange(position, it, std::next(it));
+      }
+    }
+  }
+
+  // Stable merge of [first, middle) and [middle, last). A run that fits into capacity elements is moved
+  // into buffer and merged back; otherwise the larger run is split, the halves are swapped into place
+  // with a rotation and both sides are merged recursively.
+  template< typename Iter, typename Compare, typename T >
+  void mergeBounded(Iter first, Iter middle, Iter last, size_t length1, size_t length2, Compare& cmp,
+      std::vector< T >& buffer, size_t capacity)
+  {
+    if (length1 == 0 || length2 == 0) {
+      return;
+    }
+    if (length1 + length2 == 2) {
+      if (cmp(*middle, *first)) {
+        std::iter_swap(first, middle);
+      }
+      return;
+    }
+    if (length1 <= capacity) {
+      for (Iter it = first; it != middle; ++it) {
+        buffer.push_back(std::move(*it));
+      }
+      auto left = buffer.begin();
+      Iter right = middle;
+      Iter out = first;
+      while (left != buffer.end() && right != last) {
+        if (cmp(*right, *left)) {
+          *out++ = std::move(*right++);
+        } else {
+          *out++ = std::move(*left++);
+        }
+      }
+      std::move(left, buffer.end(), out);
+      buffer.clear();
+      return;
+    }
+    if constexpr (std::is_base_of_v< std::random_access_iterator_tag,
+        typename std::iterator_traits< Iter >::iterator_category >) {
+      if (length2 <= capacity) {
+        for (Iter it = middle; it != last; ++it) {
+          buffer.push_back(std::move(*it));
+        }
+        auto right = buffer.end();
+        Iter left = middle;
+        Iter out = last;
+        while (left != first && right != buffer.begin()) {
+          if (cmp(*std::prev(right), *std::prev(left))) {
+            *--out = std::move(*--left);
+          } else {
+            *--out = std::move(*--right);
+          }
+        }
+        std::move_backward(buffer.begin(), right, out);
+        buffer.clear();
+        return;
+      }
+    }
+    Iter cut1 = first;
+    Iter cut2 = middle;
+    size_t length11 = 0;
+    size_t length22 = 0;
+    if (length1 > length2) {
+      length11 = length1 / 2;
+      std::advance(cut1, length11);
+      cut2 = std::lower_bound(middle, last, *cut1, cmp);
+      length22 = std::distance(middle, cut2);
+    } else {
+      length22 = length2 / 2;
+      std::advance(cut2, length22);
+      cut1 = std::upper_bound(first, middle, *cut2, cmp);
+      length11 = std::distance(first, cut1);
+    }
+    Iter newMiddle = rotateRange(cut1, middle, cut2);
+    mergeBounded(first, cut1, newMiddle, length11, length22, cmp, buffer, capacity);
+    mergeBounded(newMiddle, cut2, last, length1 - length11, length2 - length22, cmp, buffer, capacity);
+  }
+
+  template< typename Iter, typename Compare, typename T >
+  void mergeSortBounded(Iter first, Iter last, size_t length, Compare& cmp, std::vector< T >& buffer,
+      size_t capacity)
+  {
+    if (length <= boundedInsertionThreshold) {
+      insertionSortStable(first, last, cmp);
+      return;
+    }
+    size_t half = length / 2;
+    Iter mid = std::next(first, half);
+    mergeSortBounded(first, mid, half, cmp, buffer, capacity);
+    mergeSortBounded(mid, last, length - half, cmp, buffer, capacity);
+    mergeBounded(first, mid, last, half, length - half, cmp, buffer, capacity);
+  }
 }
 
 namespace gorbunova {
@@ -44,14 +203,28 @@ namespace gorbunova {
   template< typename Iter, typename Compare >
   void mergeSort(Iter first, Iter last, Compare cmp)
   {
-    if (std::next(first) == last) {
-      return;
+    if constexpr (isSegmented< Iter >) {
+      segmentedSort(first, last, cmp, [](auto begin, auto end, Compare& compare) {
+        mergeSortRange(begin, end, compare);
+      });
+    } else {
+      mergeSortRange(first, last, cmp);
     }
+  }
 
-    Iter mid = std::next(first, std::distance(first, last) / 2);
-    mergeSort(first, mid, cmp);
-    mergeSort(mid, last, cmp);
-    merge(first, mid, last, cmp);
+  constexpr size_t unlimitedMemory = SIZE_MAX;
+
+  // Stable merge sort that allocates at most memoryBudget bytes of element buffer. Runs that do not fit
+  // are merged in place by rotations, so a zero budget sorts in O(1) extra memory in O(n log^2 n) time.
+  template< typename Iter, typename Compare >
+  void mergeSort(Iter first, Iter last, Compare cmp, size_t memoryBudget)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    size_t length = std::distance(first, last);
+    size_t capacity = std::min(memoryBudget / sizeof(value), length / 2);
+    std::vector< value > buffer;
+    buffer.reserve(capacity);
+    mergeSortBounded(first, last, length, cmp, buffer, capacity);
   }
 
 }
@@ -2,13 +2,16 @@
 #define ODDEVENSORT_HPP
 
 #include <iterator>
+#include "SegmentedSort.hpp"
 
-namespace gorbunova {
-
+namespace {
   template< typename Iter, typename Compare >
-  void oddEvenSort(Iter first, Iter last, Compare cmp)
+  void oddEvenSortRange(Iter first, Iter last, Compare cmp)
   {
     int size = std::distance(first, last);
+    if (size < 2) {
+      return;
+    }
     for (int i = 0; i < size; ++i) {
       Iter it = (i % 2 == 0) ? std::next(first, 2) : std::next(first);
       for (; it != last; it = (std::next(it) != last) ? std::next(it, 2) : last) {
@@ -20,4 +23,19 @@ namespace gorbunova {
   }
 }
 
+namespace gorbunova {
+
+  template< typename Iter, typename Compare >
+  void oddEvenSort(Iter first, Iter last, Compare cmp)
+  {
+    if constexpr (isSegmented< Iter >) {
+      segmentedSort(first, last, cmp, [](auto begin, auto end, Compare& compare) {
+        oddEvenSortRange(begin, end, compare);
+      });
+    } else {
+      oddEvenSortRange(first, last, cmp);
+    }
+  }
+}
+
 #endif
@@ -0,0 +1,132 @@
+#ifndef PROCESSSORT_HPP
+#define PROCESSSORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "QuickSort.hpp"
+#include "SharedBuffer.hpp"
+
+namespace {
+  constexpr size_t minimumProcessChunk = 4096;
+  constexpr size_t splitterOversampling = 8;
+
+  // cuts[j][i] is where the j-th output partition starts inside the i-th sorted chunk. Elements equal to
+  // a splitter may go to either side, so they are spread over the chunks to land near the exact rank j * size / count.
+  template< typename T, typename Compare >
+  std::vector< std::vector< size_t > > chooseCuts(const T* data, const std::vector< size_t >& bounds, Compare& cmp)
+  {
+    size_t chunks = bounds.size() - 1;
+    size_t size = bounds.back();
+    std::vector< T > samples;
+    for (size_t i = 0; i < chunks; ++i) {
+      size_t length = bounds[i + 1] - bounds[i];
+      size_t count = std::min(length, splitterOversampling * chunks);
+      for (size_t k = 0; k < count; ++k) {
+        samples.push_back(data[bounds[i] + length * k / count]);
+      }
+    }
+    gorbunova::quickSort(samples.begin(), samples.end(), cmp);
+    std::vector< std::vector< size_t > > cuts(chunks + 1, std::vector< size_t >(chunks));
+    for (size_t i = 0; i < chunks; ++i) {
+      cuts.front()[i] = bounds[i];
+      cuts.back()[i] = bounds[i + 1];
+    }
+    for (size_t j = 1; j < chunks; ++j) {
+      const T& splitter = samples[samples.size() * j / chunks];
+      std::vector< size_t > lower(chunks);
+      std::vector< size_t > upper(chunks);
+      size_t below = 0;
+      for (size_t i = 0; i < chunks; ++i) {
+        lower[i] = std::lower_bound(data + bounds[i], data + bounds[i + 1], splitter, cmp) - data;
+        upper[i] = std::upper_bound(data + lower[i], data + bounds[i + 1], splitter, cmp) - data;
+        below += lower[i] - bounds[i];
+      }
+      size_t target = size * j / chunks;
+      size_t extra = target > below ? target - below : 0;
+      for (size_t i = 0; i < chunks; ++i) {
+        size_t taken = std::min(extra, upper[i] - lower[i]);
+        cuts[j][i] = lower[i] + taken;
+        extra -= taken;
+      }
+    }
+    return cuts;
+  }
+
+  template< typename T, typename Compare >
+  void mergeKWay(const T* data, const std::vector< size_t >& begins, const std::vector< size_t >& ends, T* out,
+      Compare& cmp)
+  {
+    std::vector< size_t > heads(begins);
+    std::vector< size_t > heap;
+    auto later = [&](size_t lhs, size_t rhs) {
+      return cmp(data[heads[rhs]], data[heads[lhs]]);
+    };
+    for (size_t i = 0; i < heads.size(); ++i) {
+      if (heads[i] != ends[i]) {
+        heap.push_back(i);
+      }
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), later);
+      size_t run = heap.back();
+      *out++ = data[heads[run]++];
+      if (heads[run] == ends[run]) {
+        heap.pop_back();
+      } else {
+        std::push_heap(heap.begin(), heap.end(), later);
+      }
+    }
+  }
+}
+
+namespace gorbunova {
+  // Copies the range into shared memory, sorts one chunk per forked process with sorter, then merges the chunks
+  // in parallel: sampled splitters cut every chunk into one run per process, and each process merges its runs
+  // into a second shared buffer. A crashed worker makes the call throw and leaves the range unchanged.
+  template< typename Iter, typename Compare, typename Sorter >
+  void processSort(Iter first, Iter last, Compare cmp, Sorter sorter, size_t processes)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    static_assert(std::is_trivially_copyable_v< value >, "processSort needs trivially copyable elements");
+    size_t size = std::distance(first, last);
+    if (size < 2) {
+      return;
+    }
+    processes = std::max< size_t >(1, std::min(processes, size / minimumProcessChunk));
+    SharedBuffer input(size * sizeof(value));
+    value* data = static_cast< value* >(input.data());
+    std::copy(first, last, data);
+    std::vector< size_t > bounds;
+    for (size_t i = 0; i <= processes; ++i) {
+      bounds.push_back(size * i / processes);
+    }
+    runProcesses(processes, [&](size_t i) {
+      sorter(data + bounds[i], data + bounds[i + 1], cmp);
+    });
+    if (processes == 1) {
+      std::copy(data, data + size, first);
+      return;
+    }
+    std::vector< std::vector< size_t > > cuts = chooseCuts(data, bounds, cmp);
+    std::vector< size_t > offsets{ 0 };
+    for (size_t j = 1; j <= processes; ++j) {
+      size_t offset = 0;
+      for (size_t i = 0; i < processes; ++i) {
+        offset += cuts[j][i] - bounds[i];
+      }
+      offsets.push_back(offset);
+    }
+    SharedBuffer output(size * sizeof(value));
+    value* merged = static_cast< value* >(output.data());
+    runProcesses(processes, [&](size_t j) {
+      mergeKWay(data, cuts[j], cuts[j + 1], merged + offsets[j], cmp);
+    });
+    std::copy(merged, merged + size, first);
+  }
+}
+
+#endif
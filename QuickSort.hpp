@@ -1,8 +1,19 @@
 #ifndef QUICKSORT_HPP
 #define QUICKSORT_HPP
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
+#include "SegmentedSort.hpp"
 
 namespace {
+  constexpr size_t partitionBlock = 64;
+
+  template< typename Iter >
+  constexpr bool useBlockPartition = std::is_base_of_v< std::random_access_iterator_tag,
+      typename std::iterator_traits< Iter >::iterator_category >
+    && std::is_arithmetic_v< typename std::iterator_traits< Iter >::value_type >;
+
   template< typename Iter, typename Compare >
   Iter partition(Iter first, Iter last, Compare cmp) {
     Iter pivot = first;
@@ -15,21 +26,110 @@ namespace {
     std::swap(*i, *first);
     return i;
   }
-}
 
-namespace gorbunova {
+  template< typename Iter, typename Compare >
+  void medianToFront(Iter first, Iter last, Compare cmp)
+  {
+    Iter middle = first + (last - first) / 2;
+    Iter back = std::prev(last);
+    if (cmp(*middle, *first)) {
+      std::iter_swap(middle, first);
+    }
+    if (cmp(*back, *middle)) {
+      std::iter_swap(back, middle);
+      if (cmp(*middle, *first)) {
+        std::iter_swap(middle, first);
+      }
+    }
+    std::iter_swap(first, middle);
+  }
 
   template< typename Iter, typename Compare >
-  void quickSort(Iter first, Iter last, Compare cmp)
+  Iter blockPartition(Iter first, Iter last, Compare cmp)
+  {
+    if (last - first > 2) {
+      medianToFront(first, last, cmp);
+    }
+    const typename std::iterator_traits< Iter >::value_type pivot = *first;
+    Iter left = std::next(first);
+    Iter right = last;
+    unsigned char offsetsLeft[partitionBlock];
+    unsigned char offsetsRight[partitionBlock];
+    size_t countLeft = 0;
+    size_t countRight = 0;
+    size_t startLeft = 0;
+    size_t startRight = 0;
+    while (right - left > static_cast< std::ptrdiff_t >(2 * partitionBlock)) {
+      if (countLeft == 0) {
+        startLeft = 0;
+        for (size_t i = 0; i < partitionBlock; ++i) {
+          offsetsLeft[countLeft] = static_cast< unsigned char >(i);
+          countLeft += !cmp(left[i], pivot);
+        }
+      }
+      if (countRight == 0) {
+        startRight = 0;
+        for (size_t i = 0; i < partitionBlock; ++i) {
+          offsetsRight[countRight] = static_cast< unsigned char >(i);
+          countRight += cmp(*(right - 1 - i), pivot);
+        }
+      }
+      size_t count = std::min(countLeft, countRight);
+      for (size_t i = 0; i < count; ++i) {
+        std::iter_swap(left + offsetsLeft[startLeft + i], right - 1 - offsetsRight[startRight + i]);
+      }
+      countLeft -= count;
+      countRight -= count;
+      startLeft += count;
+      startRight += count;
+      if (countLeft == 0) {
+        left += partitionBlock;
+      }
+      if (countRight == 0) {
+        right -= partitionBlock;
+      }
+    }
+    Iter i = left;
+    for (Iter j = left; j != right; ++j) {
+      if (cmp(*j, pivot)) {
+        std::iter_swap(i++, j);
+      }
+    }
+    std::iter_swap(first, --i);
+    return i;
+  }
+
+  template< typename Iter, typename Compare >
+  void quickSortRange(Iter first, Iter last, Compare cmp)
   {
     if (first == last || std::next(first) == last) {
       return;
     }
 
-    Iter pivot = partition(first, last, cmp);
-    quickSort(first, pivot, cmp);
-    quickSort(std::next(pivot), last, cmp);
+    Iter pivot;
+    if constexpr (useBlockPartition< Iter >) {
+      pivot = ::blockPartition(first, last, cmp);
+    } else {
+      pivot = ::partition(first, last, cmp);
+    }
+    quickSortRange(first, pivot, cmp);
+    quickSortRange(std::next(pivot), last, cmp);
+  }
+}
+
+namespace gorbunova {
+
+  template< typename Iter, typename Compare >
+  void quickSort(Iter first, Iter last, Compare cmp)
+  {
+    if constexpr (isSegmented< Iter >) {
+      segmentedSort(first, last, cmp, [](auto begin, auto end, Compare& compare) {
+        quickSortRange(begin, end, compare);
+      });
+    } else {
+      quickSortRange(first, last, cmp);
+    }
   }
 }
 
-#endif
\ No newline at end of file
+#endif
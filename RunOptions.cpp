@@ -0,0 +1,53 @@
+#include "RunOptions.hpp"
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+  constexpr size_t maxThreads = 256;
+}
+
+gorbunova::RunOptions gorbunova::parseOptions(int count, char** args)
+{
+  RunOptions options;
+  for (int i = 0; i < count; ++i) {
+    std::string option = args[i];
+    if (option == "--bench") {
+      options.benchmark = true;
+    } else if (option == "--hybrid") {
+      options.hybrid = true;
+    } else if (option == "--indirect") {
+      options.indirect = true;
+    } else if (option == "--auto") {
+      options.automatic = true;
+    } else if (option == "--distribution") {
+      options.distribution = true;
+    } else if (option == "--verify") {
+      options.verify = true;
+    } else if (option == "--parallel") {
+      options.threads = std::thread::hardware_concurrency();
+    } else if (option.rfind("--threads=", 0) == 0) {
+      options.threads = std::stoull(option.substr(10));
+      if (options.threads > maxThreads) {
+        throw std::logic_error("Invalid option!");
+      }
+    } else if (option.rfind("--processes=", 0) == 0) {
+      options.processes = std::stoull(option.substr(12));
+    } else if (option.rfind("--memory=", 0) == 0) {
+      options.memoryBudget = std::stoull(option.substr(9));
+    } else if (option.rfind("--head=", 0) == 0) {
+      options.head = std::stoull(option.substr(7));
+    } else if (option.rfind("--input=", 0) == 0) {
+      options.input = option.substr(8);
+    } else {
+      throw std::logic_error("Invalid option!");
+    }
+  }
+  if (options.hybrid + options.indirect + options.distribution + options.automatic > 1) {
+    throw std::logic_error("Invalid option!");
+  }
+  if (options.processes != 0 && options.threads != 0) {
+    throw std::logic_error("Invalid option!");
+  }
+  return options;
+}
@@ -0,0 +1,24 @@
+#ifndef RUN_OPTIONS_HPP
+#define RUN_OPTIONS_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gorbunova {
+  struct RunOptions {
+    bool benchmark = false;
+    bool hybrid = false;
+    bool indirect = false;
+    bool automatic = false;
+    bool distribution = false;
+    bool verify = false;
+    size_t threads = 0;
+    size_t processes = 0;
+    size_t memoryBudget = SIZE_MAX;
+    size_t head = SIZE_MAX;
+    std::string input;
+  };
+
+  RunOptions parseOptions(int count, char** args);
+}
+#endif
@@ -0,0 +1,100 @@
+#ifndef SEGMENTEDSORT_HPP
+#define SEGMENTEDSORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace {
+  template< typename Iter >
+  constexpr bool isSegmented = std::is_same_v< Iter,
+      typename std::deque< typename std::iterator_traits< Iter >::value_type >::iterator >;
+
+  // Whether the element after it lives in the same deque block. libstdc++ exposes the block bounds through
+  // its iterator, but _M_cur and _M_last are private to the library version, so they are only read here.
+  // Elsewhere the test falls back to address adjacency, which the standard does not promise to stop at a
+  // block boundary; a block allocated right after another is then sorted with it as one segment.
+  template< typename Iter >
+  bool continuesBlock(Iter it)
+  {
+#ifdef __GLIBCXX__
+    return it._M_cur + 1 != it._M_last;
+#else
+    Iter next = std::next(it);
+    return std::addressof(*next) == std::addressof(*it) + 1;
+#endif
+  }
+
+  // Steps the iterator to the end of the block holding first: one iterator increment and one
+  // block test per element, no deque index arithmetic.
+  template< typename Iter >
+  typename std::iterator_traits< Iter >::pointer segmentEnd(Iter first, Iter last)
+  {
+    auto begin = std::addressof(*first);
+    std::ptrdiff_t length = 1;
+    for (Iter it = first; std::next(it) != last && continuesBlock(it); ++it) {
+      ++length;
+    }
+    return begin + length;
+  }
+
+  template< typename T, typename Compare >
+  void mergeRuns(std::vector< T >& runs, std::vector< size_t >& bounds, Compare& cmp)
+  {
+    std::vector< T > merged;
+    merged.reserve(runs.size());
+    while (bounds.size() > 2) {
+      std::vector< size_t > mergedBounds{ 0 };
+      for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+        auto begin = std::make_move_iterator(runs.begin() + bounds[i]);
+        auto middle = std::make_move_iterator(runs.begin() + bounds[i + 1]);
+        if (i + 2 < bounds.size()) {
+          auto end = std::make_move_iterator(runs.begin() + bounds[i + 2]);
+          std::merge(begin, middle, middle, end, std::back_inserter(merged), cmp);
+        } else {
+          std::copy(begin, middle, std::back_inserter(merged));
+        }
+        mergedBounds.push_back(merged.size());
+      }
+      runs.swap(merged);
+      merged.clear();
+      bounds.swap(mergedBounds);
+    }
+  }
+
+  // Sorts every contiguous block of a deque range with kernel on raw pointers,
+  // then merges the sorted blocks bottom-up through a buffer. The merge holds up to two vectors of
+  // last - first elements, so deque ranges are not sorted in place even by in-place kernels.
+  template< typename Iter, typename Compare, typename Kernel >
+  void segmentedSort(Iter first, Iter last, Compare cmp, Kernel kernel)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    std::vector< value* > segments;
+    for (Iter it = first; it != last;) {
+      value* begin = std::addressof(*it);
+      value* end = segmentEnd(it, last);
+      kernel(begin, end, cmp);
+      segments.push_back(begin);
+      segments.push_back(end);
+      it += end - begin;
+    }
+    if (segments.size() <= 2) {
+      return;
+    }
+    std::vector< value > runs;
+    runs.reserve(last - first);
+    std::vector< size_t > bounds{ 0 };
+    for (size_t i = 0; i < segments.size(); i += 2) {
+      std::move(segments[i], segments[i + 1], std::back_inserter(runs));
+      bounds.push_back(runs.size());
+    }
+    mergeRuns(runs, bounds, cmp);
+    std::move(runs.begin(), runs.end(), first);
+  }
+}
+
+#endif
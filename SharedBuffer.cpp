@@ -0,0 +1,85 @@
+#include "SharedBuffer.hpp"
+#include <cerrno>
+#include <stdexcept>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+gorbunova::SharedBuffer::SharedBuffer(size_t size):
+  data_(nullptr),
+  size_(size)
+{
+  if (size_ == 0) {
+    return;
+  }
+  int fd = memfd_create("gorbunova-sort", MFD_CLOEXEC);
+  if (fd < 0) {
+    throw std::logic_error("Cannot create shared memory!");
+  }
+  if (ftruncate(fd, size_) != 0) {
+    close(fd);
+    throw std::logic_error("Cannot create shared memory!");
+  }
+  void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::logic_error("Cannot create shared memory!");
+  }
+  data_ = data;
+}
+
+gorbunova::SharedBuffer::~SharedBuffer()
+{
+  if (data_) {
+    munmap(data_, size_);
+  }
+}
+
+void* gorbunova::SharedBuffer::data() const noexcept
+{
+  return data_;
+}
+
+size_t gorbunova::SharedBuffer::getSize() const noexcept
+{
+  return size_;
+}
+
+void gorbunova::runProcesses(size_t count, const std::function< void(size_t) >& task)
+{
+  std::vector< pid_t > workers;
+  bool failed = false;
+  for (size_t i = 0; i < count; ++i) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      failed = true;
+      break;
+    }
+    if (pid == 0) {
+      int status = 0;
+      try {
+        task(i);
+      } catch (...) {
+        status = 1;
+      }
+      _exit(status);
+    }
+    workers.push_back(pid);
+  }
+  for (pid_t pid : workers) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+      if (errno != EINTR) {
+        failed = true;
+        break;
+      }
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      failed = true;
+    }
+  }
+  if (failed) {
+    throw std::logic_error("Worker process failed!");
+  }
+}
@@ -0,0 +1,28 @@
+#ifndef SHARED_BUFFER_HPP
+#define SHARED_BUFFER_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace gorbunova {
+  // Memory backed by a memfd and mapped MAP_SHARED, so processes forked after construction see each other's writes.
+  class SharedBuffer {
+    public:
+    explicit SharedBuffer(size_t size);
+    SharedBuffer(const SharedBuffer&) = delete;
+    ~SharedBuffer();
+    SharedBuffer& operator=(const SharedBuffer&) = delete;
+
+    void* data() const noexcept;
+    size_t getSize() const noexcept;
+
+    private:
+    void* data_;
+    size_t size_;
+  };
+
+  // Forks count worker processes, runs task(i) in the i-th and waits for all of them.
+  // Throws if a worker could not be started, threw, or was killed.
+  void runProcesses(size_t count, const std::function< void(size_t) >& task);
+}
+#endif
@@ -1,14 +1,31 @@
 #ifndef SORTCOLLECTIONS_HPP
 #define SORTCOLLECTIONS_HPP
 
+#include <array>
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <future>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
 #include "QuickSort.hpp"
 #include "OddEvenSort.hpp"
 #include "MergeSort.hpp"
+#include "ProcessSort.hpp"
 #include "ForwardList.hpp"
 #include "BidirectionalList.hpp"
+#include "AutoSort.hpp"
+#include "DistributionSort.hpp"
+#include "HybridSort.hpp"
+#include "IndirectSort.hpp"
+#include "LazySort.hpp"
+#include "StringSort.hpp"
+#include "ThreadPool.hpp"
+#include "Verify.hpp"
 
 namespace {
   template< typename T >
@@ -17,6 +34,48 @@ namespace {
     return static_cast< T >((std::rand() * 100.0 / RAND_MAX));
   }
 
+  template<>
+  inline std::string getRandom< std::string >()
+  {
+    static const char* const prefixes[] = { "user/", "user/id-", "order/", "order/item-" };
+    return prefixes[std::rand() % 4] + std::to_string(std::rand() % 100000);
+  }
+
+  template< typename T >
+  std::deque< T > generateCollection(size_t size)
+  {
+    std::deque< T > data;
+    for (size_t i = 0; i < size; ++i) {
+      data.push_back(getRandom< T >());
+    }
+    return data;
+  }
+
+  template< typename T >
+  std::deque< T > readCollection(std::istream& in, size_t size)
+  {
+    std::deque< T > data;
+    T value;
+    while (data.size() < size && in >> value) {
+      data.push_back(value);
+    }
+    if (!in && !in.eof()) {
+      throw std::logic_error("Invalid input!");
+    }
+    return data;
+  }
+
+  template< typename T >
+  std::function< bool(const T&, const T&) > makeComparator(const std::string& direction)
+  {
+    if (direction == "ascending") {
+      return std::less<>();
+    } else if (direction == "descending") {
+      return std::greater<>();
+    }
+    throw std::logic_error("Invalid direction!");
+  }
+
   template< typename Iterator >
   std::ostream& printCollection(std::ostream& out, Iterator begin, Iterator end)
   {
@@ -29,6 +88,23 @@ namespace {
     return out;
   }
 
+  template< typename Container >
+  std::ostream& printCollection(std::ostream& out, Container& container)
+  {
+    bool separate = false;
+    auto print = [&out, &separate](const auto& value) {
+      if (separate) {
+        out << ' ';
+      }
+      out << value;
+      separate = true;
+    };
+    for (const auto& value : container) {
+      print(value);
+    }
+    return out;
+  }
+
   template< typename T >
   void fillBidirectional(gorbunova::BidirectionalList< T >& b, std::deque< T >& d)
   {
@@ -44,44 +120,214 @@ namespace {
       b.pushBack(*it);
     }
   }
+
+  template< typename T >
+  void fillCollection(std::deque< T >& b, std::deque< T >& d)
+  {
+    b.insert(b.begin(), d.begin(), d.end());
+  }
+
+  template< typename T >
+  void fillCollection(gorbunova::BidirectionalList< T >& b, std::deque< T >& d)
+  {
+    fillBidirectional(b, d);
+  }
+
+  template< typename T >
+  void fillCollection(gorbunova::ForwardList< T >& b, std::deque< T >& d)
+  {
+    fillForward(b, d);
+  }
+
+  struct OddEvenSorter {
+    template< typename Iter, typename Compare >
+    void operator()(Iter first, Iter last, Compare cmp) const
+    {
+      gorbunova::oddEvenSort(first, last, cmp);
+    }
+  };
+
+  struct QuickSorter {
+    template< typename Iter, typename Compare >
+    void operator()(Iter first, Iter last, Compare cmp) const
+    {
+      gorbunova::quickSort(first, last, cmp);
+    }
+  };
+
+  struct MergeSorter {
+    size_t memoryBudget = gorbunova::unlimitedMemory;
+
+    template< typename Iter, typename Compare >
+    void operator()(Iter first, Iter last, Compare cmp) const
+    {
+      if (memoryBudget == gorbunova::unlimitedMemory) {
+        gorbunova::mergeSort(first, last, cmp);
+      } else {
+        gorbunova::mergeSort(first, last, cmp, memoryBudget);
+      }
+    }
+  };
+
+  struct StringSorter {
+    bool descending;
+
+    template< typename Iter, typename Compare >
+    void operator()(Iter first, Iter last, Compare) const
+    {
+      gorbunova::stringSort(first, last, descending);
+    }
+  };
 }
 
 
 namespace gorbunova {
+  enum class Collection {
+    oddEven1,
+    oddEven2,
+    quick1,
+    quick2,
+    quick3,
+    merge1,
+    radix1
+  };
+
+  enum class SortMode {
+    inPlace,
+    hybrid,
+    indirect,
+    automatic,
+    distribution
+  };
+
+  constexpr size_t collectionsCount = 7;
+
+  inline const char* collectionName(Collection collection)
+  {
+    static constexpr const char* names[collectionsCount] = {
+      "oddEven1", "oddEven2", "quick1", "quick2", "quick3", "merge1", "radix1"
+    };
+    return names[static_cast< size_t >(collection)];
+  }
+
   template< typename T >
   class SortCollections {
     public:
     SortCollections() = delete;
 
-    SortCollections(size_t size,const std::string& direction)
+    SortCollections(size_t size, const std::string& direction, ThreadPool* pool = nullptr):
+      SortCollections(generateCollection< T >(size), direction, pool)
+    {}
+
+    SortCollections(std::deque< T > data, const std::string& direction, ThreadPool* pool = nullptr):
+      oddEven1(std::move(data)),
+      cmp(makeComparator< T >(direction)),
+      descending_(direction == "descending"),
+      pool_(pool),
+      log_(nullptr),
+      memoryBudget_(unlimitedMemory),
+      processes_(0)
     {
-      if (direction == "ascending") {
-        cmp = std::less<>();
-      } else if (direction == "descending") {
-        cmp = std::greater<>();
-      } else {
-        throw std::logic_error("Invalid direction!");
+      for (size_t i = 1; i < count_; ++i) {
+        Collection collection = static_cast< Collection >(i);
+        if (pool_) {
+          filled_[i] = pool_->submit([this, collection]() {
+            fillCollection(collection);
+          });
+        } else {
+          fillCollection(collection);
+        }
       }
-      for (size_t i = 0; i < size; ++i) {
-        oddEven1.push_back(getRandom< T >());
+    }
+
+    ~SortCollections()
+    {
+      for (size_t i = 0; i < count_; ++i) {
+        if (filled_[i].valid()) {
+          filled_[i].wait();
+        }
+        if (sorted_[i].valid()) {
+          sorted_[i].wait();
+        }
       }
-      merge1.insert(merge1.begin(), oddEven1.begin(), oddEven1.end());
-      quick1.insert(quick1.begin(), oddEven1.begin(), oddEven1.end());
-      fillBidirectional(quick2, oddEven1);
-      fillBidirectional(oddEven2, oddEven1);
-      fillForward(quick3, oddEven1);
+    }
+
+    void setMode(Collection collection, SortMode mode)
+    {
+      modes_[static_cast< size_t >(collection)] = mode;
+    }
+
+    void setMode(SortMode mode)
+    {
+      modes_.fill(mode);
+    }
+
+    void setLog(std::ostream* log)
+    {
+      log_ = log;
+    }
+
+    void setMemoryBudget(size_t memoryBudget)
+    {
+      memoryBudget_ = memoryBudget;
+    }
+
+    // processSort forks, so this must not be combined with a pool: a child could inherit locks held by its threads.
+    void setProcesses(size_t processes)
+    {
+      processes_ = processes;
     }
 
     std::ostream& printCollections(std::ostream& out)
     {
-      printCollection(out, oddEven1.begin(), oddEven1.end()) << "\n";
+      ::printCollection(out, oddEven1.begin(), oddEven1.end()) << "\n";
+      sortCollections();
+      for (size_t i = 0; i < count_; ++i) {
+        waitSorted(i);
+        if (i != 0) {
+          out << "\n";
+        }
+        printCollection(out, static_cast< Collection >(i));
+      }
+      return out;
+    }
+
+    std::ostream& printHeads(std::ostream& out, size_t count)
+    {
+      ::printCollection(out, oddEven1.begin(), oddEven1.end()) << "\n";
+      for (size_t i = 0; i < count_; ++i) {
+        if (filled_[i].valid()) {
+          filled_[i].get();
+        }
+        if (i != 0) {
+          out << "\n";
+        }
+        visit(static_cast< Collection >(i), [this, &out, count](auto& container, auto) {
+          Generator< T > head = take(sortedView(container.begin(), container.end(), cmp), count);
+          ::printCollection(out, head);
+        });
+      }
+      return out;
+    }
+
+    bool verifyCollections(std::ostream& out)
+    {
+      uint64_t expected = multisetChecksum(oddEven1.begin(), oddEven1.end(), pool_);
       sortCollections();
-      printCollection(out, oddEven1.begin(), oddEven1.end()) << "\n";
-      printCollection(out, oddEven2.begin(), oddEven2.end()) << "\n";
-      printCollection(out, quick1.begin(), quick1.end()) << "\n";
-      printCollection(out, quick2.begin(), quick2.end()) << "\n";
-      printCollection(out, quick3.begin(), quick3.end()) << "\n";
-      return printCollection(out, merge1.begin(), merge1.end());
+      bool verified = true;
+      for (size_t i = 0; i < count_; ++i) {
+        waitSorted(i);
+        Collection collection = static_cast< Collection >(i);
+        visit(collection, [&](auto& container, auto) {
+          bool sorted = isSorted(container.begin(), container.end(), cmp, pool_);
+          bool complete = multisetChecksum(container.begin(), container.end(), pool_) == expected;
+          out << collectionName(collection) << ": " << std::distance(container.begin(), container.end());
+          out << " elements, " << (sorted ? "sorted" : "NOT SORTED");
+          out << ", checksum " << (complete ? "ok" : "MISMATCH") << "\n";
+          verified = verified && sorted && complete;
+        });
+      }
+      return verified;
     }
 
     private:
@@ -91,17 +337,127 @@ namespace gorbunova {
     gorbunova::BidirectionalList< T > oddEven2;
     gorbunova::BidirectionalList< T > quick2;
     gorbunova::ForwardList< T > quick3;
-    std::function< bool(T, T) > cmp;
+    std::deque< T > radix1;
+    std::function< bool(const T&, const T&) > cmp;
+    bool descending_;
+    std::array< SortMode, collectionsCount > modes_{};
+    ThreadPool* pool_;
+    std::ostream* log_;
+    std::mutex logMutex_;
+    size_t memoryBudget_;
+    size_t processes_;
+    std::array< std::future< void >, collectionsCount > filled_;
+    std::array< std::future< void >, collectionsCount > sorted_;
 
-    void sortCollections() {
-      gorbunova::oddEvenSort(oddEven1.begin(), oddEven1.end(), cmp);
-      gorbunova::oddEvenSort(oddEven2.begin(), oddEven2.end(), cmp);
-      gorbunova::quickSort(quick1.begin(), quick1.end(), cmp);
-      gorbunova::quickSort(quick2.begin(), quick2.end(), cmp);
-      gorbunova::quickSort(quick3.begin(), quick3.end(), cmp);
-      gorbunova::mergeSort(merge1.begin(), merge1.end(), cmp);
+    static constexpr size_t count_ = std::is_same_v< T, std::string > ? collectionsCount : collectionsCount - 1;
+
+    template< typename F >
+    void visit(Collection collection, F f)
+    {
+      switch (collection) {
+        case Collection::oddEven1:
+          f(oddEven1, OddEvenSorter());
+          break;
+        case Collection::oddEven2:
+          f(oddEven2, OddEvenSorter());
+          break;
+        case Collection::quick1:
+          f(quick1, QuickSorter());
+          break;
+        case Collection::quick2:
+          f(quick2, QuickSorter());
+          break;
+        case Collection::quick3:
+          f(quick3, QuickSorter());
+          break;
+        case Collection::merge1:
+          f(merge1, MergeSorter{ memoryBudget_ });
+          break;
+        case Collection::radix1:
+          if constexpr (std::is_same_v< T, std::string >) {
+            f(radix1, StringSorter{ descending_ });
+          }
+          break;
+      }
+    }
+
+    void fillCollection(Collection collection)
+    {
+      visit(collection, [this](auto& container, auto) {
+        ::fillCollection(container, oddEven1);
+      });
+    }
+
+    void printCollection(std::ostream& out, Collection collection)
+    {
+      visit(collection, [&out](auto& container, auto) {
+        ::printCollection(out, container);
+      });
+    }
+
+    void sortCollection(Collection collection)
+    {
+      visit(collection, [this, collection](auto& container, auto sorter) {
+        if constexpr (std::is_trivially_copyable_v< T >) {
+          if (processes_ != 0) {
+            gorbunova::processSort(container.begin(), container.end(), cmp, sorter, processes_);
+            return;
+          }
+        }
+        SortMode mode = modes_[static_cast< size_t >(collection)];
+        if (mode == SortMode::hybrid) {
+          gorbunova::hybridSort(container.begin(), container.end(), cmp, sorter);
+        } else if (mode == SortMode::distribution) {
+          if constexpr (std::is_arithmetic_v< T >) {
+            gorbunova::distributionSort(container.begin(), container.end(), cmp);
+          } else {
+            sorter(container.begin(), container.end(), cmp);
+          }
+        } else if (mode == SortMode::indirect || mode == SortMode::automatic) {
+          if constexpr (std::is_same_v< decltype(sorter), StringSorter >) {
+            sorter(container.begin(), container.end(), cmp);
+          } else if (mode == SortMode::indirect) {
+            gorbunova::indirectSort(container.begin(), container.end(), cmp, sorter);
+          } else {
+            std::ostringstream log;
+            gorbunova::autoSort(container.begin(), container.end(), cmp, log_ ? &log : nullptr);
+            if (log_) {
+              std::lock_guard< std::mutex > lock(logMutex_);
+              *log_ << collectionName(collection) << ": " << log.str();
+            }
+          }
+        } else {
+          sorter(container.begin(), container.end(), cmp);
+        }
+      });
+    }
+
+    void sortCollections()
+    {
+      if (!pool_) {
+        for (size_t i = 0; i < count_; ++i) {
+          sortCollection(static_cast< Collection >(i));
+        }
+        return;
+      }
+      for (size_t i = 1; i < count_; ++i) {
+        filled_[i].get();
+        sorted_[i] = pool_->submit([this, i]() {
+          sortCollection(static_cast< Collection >(i));
+        });
+      }
+      sorted_[0] = pool_->submit([this]() {
+        sortCollection(Collection::oddEven1);
+      });
+    }
+
+    void waitSorted(size_t index)
+    {
+      if (sorted_[index].valid()) {
+        sorted_[index].get();
+      }
     }
   };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,297 @@
+#include "SortServer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <poll.h>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "AutoSort.hpp"
+#include "SortCollections.hpp"
+#include "StreamGuard.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+  constexpr size_t latencyWindow = 65536;
+  constexpr size_t maxRequestLength = size_t(64) << 20;
+  constexpr std::chrono::milliseconds acceptBackoff(50);
+
+  // Answered as any malformed request would be, in order after the client's earlier requests; the rest of
+  // the oversized line is read and dropped so the connection stays usable.
+  const char* const oversizedRequest = "oversized";
+
+  // Lines read from a client wait in lines until the one task draining them answers in order; the socket
+  // is closed when neither the polling thread nor that task holds the connection any more.
+  struct Connection {
+    int fd;
+    std::string received;
+    bool discarding;
+    std::mutex mutex;
+    std::queue< std::string > lines;
+    bool busy;
+
+    explicit Connection(int descriptor):
+      fd(descriptor),
+      discarding(false),
+      busy(false)
+    {}
+
+    ~Connection()
+    {
+      close(fd);
+    }
+  };
+
+  void sendAll(int fd, const std::string& data)
+  {
+    for (size_t sent = 0; sent < data.size();) {
+      ssize_t count = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return;
+      }
+      sent += count;
+    }
+  }
+
+  template< typename T >
+  void sortRequest(std::istream& in, std::ostream& out, const std::string& direction, size_t size)
+  {
+    thread_local std::vector< T > scratch;
+    std::function< bool(const T&, const T&) > cmp = makeComparator< T >(direction);
+    scratch.clear();
+    T value;
+    while (scratch.size() < size && in >> value) {
+      scratch.push_back(value);
+    }
+    if (scratch.size() != size || !(in >> std::ws).eof()) {
+      throw std::logic_error("Invalid input!");
+    }
+    gorbunova::autoSort(scratch.begin(), scratch.end(), cmp);
+    if constexpr (std::is_floating_point_v< T >) {
+      gorbunova::StreamGuard guard(out);
+      out << std::setprecision(std::numeric_limits< T >::max_digits10);
+      printCollection(out, scratch.begin(), scratch.end()) << '\n';
+    } else {
+      printCollection(out, scratch.begin(), scratch.end()) << '\n';
+    }
+  }
+}
+
+gorbunova::SortServer::SortServer(size_t threads):
+  threads_(threads),
+  started_(Clock::now()),
+  requests_(0),
+  elements_(0),
+  errors_(0)
+{
+  latencies_.reserve(latencyWindow);
+}
+
+void gorbunova::SortServer::serve(std::istream& in, std::ostream& out)
+{
+  std::string line;
+  while (std::getline(in, line)) {
+    answer(line, out);
+    out.flush();
+  }
+}
+
+void gorbunova::SortServer::listen(const std::string& path)
+{
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::logic_error("Invalid socket path!");
+  }
+  std::strcpy(address.sun_path, path.c_str());
+  int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0) {
+    throw std::logic_error("Cannot open socket!");
+  }
+  unlink(path.c_str());
+  if (bind(server, reinterpret_cast< sockaddr* >(&address), sizeof(address)) != 0 || ::listen(server, SOMAXCONN) != 0) {
+    close(server);
+    throw std::logic_error("Cannot open socket!");
+  }
+  ThreadPool pool(threads_);
+  std::vector< pollfd > descriptors{ pollfd{ server, POLLIN, 0 } };
+  std::vector< std::shared_ptr< Connection > > connections;
+  auto dispatch = [this, &pool](const std::shared_ptr< Connection >& connection, std::string line) {
+    {
+      std::lock_guard< std::mutex > lock(connection->mutex);
+      connection->lines.push(std::move(line));
+      if (connection->busy) {
+        return;
+      }
+      connection->busy = true;
+    }
+    pool.submit([this, connection]() {
+      while (true) {
+        std::string request;
+        {
+          std::lock_guard< std::mutex > lock(connection->mutex);
+          if (connection->lines.empty()) {
+            connection->busy = false;
+            return;
+          }
+          request = std::move(connection->lines.front());
+          connection->lines.pop();
+        }
+        std::ostringstream out;
+        answer(request, out);
+        sendAll(connection->fd, out.str());
+      }
+    });
+  };
+  while (true) {
+    if (poll(descriptors.data(), descriptors.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (size_t i = descriptors.size() - 1; i > 0; --i) {
+      if (descriptors[i].revents == 0) {
+        continue;
+      }
+      std::shared_ptr< Connection > connection = connections[i - 1];
+      char buffer[4096];
+      ssize_t count = read(connection->fd, buffer, sizeof(buffer));
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        if (!connection->received.empty() && !connection->discarding) {
+          dispatch(connection, std::move(connection->received));
+        }
+        descriptors.erase(descriptors.begin() + i);
+        connections.erase(connections.begin() + (i - 1));
+        continue;
+      }
+      size_t scanned = connection->received.size();
+      connection->received.append(buffer, count);
+      size_t begin = 0;
+      for (size_t end = connection->received.find('\n', scanned); end != std::string::npos;
+          end = connection->received.find('\n', begin)) {
+        if (connection->discarding) {
+          connection->discarding = false;
+        } else {
+          dispatch(connection, connection->received.substr(begin, end - begin));
+        }
+        begin = end + 1;
+      }
+      connection->received.erase(0, begin);
+      if (connection->received.size() > maxRequestLength) {
+        if (!connection->discarding) {
+          dispatch(connection, oversizedRequest);
+          connection->discarding = true;
+        }
+        connection->received.clear();
+      }
+    }
+    if (descriptors.front().revents & POLLIN) {
+      int client = accept(server, nullptr, nullptr);
+      if (client >= 0) {
+        descriptors.push_back(pollfd{ client, POLLIN, 0 });
+        connections.push_back(std::make_shared< Connection >(client));
+      } else if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+        std::this_thread::sleep_for(acceptBackoff);
+      } else if (errno != EINTR && errno != ECONNABORTED) {
+        break;
+      }
+    }
+  }
+  close(server);
+  throw std::logic_error("Cannot accept connections!");
+}
+
+void gorbunova::SortServer::answer(const std::string& line, std::ostream& out)
+{
+  std::istringstream request(line);
+  std::string command;
+  if (!(request >> command)) {
+    return;
+  }
+  if (command == "stats") {
+    printStats(out) << '\n';
+    return;
+  }
+  Clock::time_point start = Clock::now();
+  try {
+    std::string type;
+    size_t size = 0;
+    if (!(request >> type >> size)) {
+      throw std::logic_error("Invalid command!");
+    }
+    if (type == "ints") {
+      sortRequest< int >(request, out, command, size);
+    } else if (type == "floats") {
+      sortRequest< float >(request, out, command, size);
+    } else if (type == "strings") {
+      sortRequest< std::string >(request, out, command, size);
+    } else {
+      throw std::logic_error("Invalid type!");
+    }
+    std::chrono::duration< double, std::micro > latency = Clock::now() - start;
+    record(latency.count(), size);
+  } catch (const std::exception&) {
+    fail();
+    out << "<INVALID COMMAND>\n";
+  }
+}
+
+std::ostream& gorbunova::SortServer::printStats(std::ostream& out)
+{
+  std::vector< double > latencies;
+  size_t requests = 0;
+  size_t elements = 0;
+  size_t errors = 0;
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    latencies = latencies_;
+    requests = requests_;
+    elements = elements_;
+    errors = errors_;
+  }
+  std::chrono::duration< double > uptime = Clock::now() - started_;
+  out << "requests " << requests << ", errors " << errors << ", elements " << elements;
+  out << ", " << requests / uptime.count() << " requests/s, " << elements / uptime.count() << " elements/s";
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    out << ", latency us";
+    for (size_t percentile : { 50, 90, 99 }) {
+      out << " p" << percentile << ' ' << latencies[(latencies.size() - 1) * percentile / 100];
+    }
+    out << " max " << latencies.back();
+  }
+  return out;
+}
+
+void gorbunova::SortServer::record(double latency, size_t elements)
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  if (latencies_.size() < latencyWindow) {
+    latencies_.push_back(latency);
+  } else {
+    latencies_[requests_ % latencyWindow] = latency;
+  }
+  ++requests_;
+  elements_ += elements;
+}
+
+void gorbunova::SortServer::fail()
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  ++errors_;
+}
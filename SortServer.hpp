@@ -0,0 +1,42 @@
+#ifndef SORT_SERVER_HPP
+#define SORT_SERVER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gorbunova {
+  // Answers "<direction> <type> <size> <values...>" lines with the sorted values on one line and "stats" with
+  // the counters. On a socket one thread polls every connection and hands complete lines to a pool that stays
+  // warm between requests; each connection gets its answers in the order it sent the requests.
+  class SortServer {
+    public:
+    explicit SortServer(size_t threads);
+    SortServer(const SortServer&) = delete;
+    SortServer& operator=(const SortServer&) = delete;
+
+    void serve(std::istream& in, std::ostream& out);
+    void listen(const std::string& path);
+    std::ostream& printStats(std::ostream& out);
+
+    private:
+    using Clock = std::chrono::steady_clock;
+
+    size_t threads_;
+    std::mutex mutex_;
+    Clock::time_point started_;
+    std::vector< double > latencies_;
+    size_t requests_;
+    size_t elements_;
+    size_t errors_;
+
+    void answer(const std::string& line, std::ostream& out);
+    void record(double latency, size_t elements);
+    void fail();
+  };
+}
+#endif
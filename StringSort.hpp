@@ -0,0 +1,153 @@
+#ifndef STRINGSORT_HPP
+#define STRINGSORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+  using StringKey = std::string*;
+
+  constexpr size_t insertionThreshold = 16;
+  constexpr size_t radixThreshold = 4096;
+  constexpr size_t alphabetSize = 257;
+  constexpr size_t radixMaxLevels = 64;
+
+  inline uint16_t charAt(StringKey key, size_t depth)
+  {
+    return depth < key->size() ? static_cast< unsigned char >((*key)[depth]) + 1 : 0;
+  }
+
+  inline bool lessFrom(StringKey lhs, StringKey rhs, size_t depth)
+  {
+    return std::string_view(*lhs).substr(depth) < std::string_view(*rhs).substr(depth);
+  }
+
+  inline void insertionSortStrings(StringKey* keys, size_t size, size_t depth)
+  {
+    for (size_t i = 1; i < size; ++i) {
+      StringKey key = keys[i];
+      size_t j = i;
+      for (; j > 0 && lessFrom(key, keys[j - 1], depth); --j) {
+        keys[j] = keys[j - 1];
+      }
+      keys[j] = key;
+    }
+  }
+
+  inline uint16_t medianOfThree(uint16_t a, uint16_t b, uint16_t c)
+  {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+  }
+
+  inline void multikeyQuickSort(StringKey* keys, uint16_t* cache, size_t size, size_t depth, bool cached)
+  {
+    while (size > insertionThreshold) {
+      if (!cached) {
+        for (size_t i = 0; i < size; ++i) {
+          cache[i] = charAt(keys[i], depth);
+        }
+      }
+      uint16_t pivot = medianOfThree(cache[0], cache[size / 2], cache[size - 1]);
+      size_t less = 0;
+      size_t i = 0;
+      size_t greater = size;
+      while (i < greater) {
+        if (cache[i] < pivot) {
+          std::swap(keys[less], keys[i]);
+          std::swap(cache[less++], cache[i++]);
+        } else if (cache[i] > pivot) {
+          --greater;
+          std::swap(keys[i], keys[greater]);
+          std::swap(cache[i], cache[greater]);
+        } else {
+          ++i;
+        }
+      }
+      multikeyQuickSort(keys, cache, less, depth, true);
+      multikeyQuickSort(keys + greater, cache + greater, size - greater, depth, true);
+      if (pivot == 0) {
+        return;
+      }
+      keys += less;
+      cache += less;
+      size = greater - less;
+      ++depth;
+      cached = false;
+    }
+    insertionSortStrings(keys, size, depth);
+  }
+
+  // A group whose keys all share the next character moves on to the following one in place, so long common
+  // prefixes cost no stack; groups still unsplit after radixMaxLevels nested buckets go to multikeyQuickSort.
+  inline void msdRadixSort(StringKey* keys, StringKey* buffer, uint16_t* cache, size_t size, size_t depth,
+      size_t level = 0)
+  {
+    if (size < radixThreshold || level == radixMaxLevels) {
+      multikeyQuickSort(keys, cache, size, depth, false);
+      return;
+    }
+    size_t counts[alphabetSize] = {};
+    while (true) {
+      std::fill(counts, counts + alphabetSize, 0);
+      for (size_t i = 0; i < size; ++i) {
+        cache[i] = charAt(keys[i], depth);
+        ++counts[cache[i]];
+      }
+      if (counts[cache[0]] != size) {
+        break;
+      }
+      if (cache[0] == 0) {
+        return;
+      }
+      ++depth;
+    }
+    size_t offsets[alphabetSize] = {};
+    for (size_t c = 1; c < alphabetSize; ++c) {
+      offsets[c] = offsets[c - 1] + counts[c - 1];
+    }
+    for (size_t i = 0; i < size; ++i) {
+      buffer[offsets[cache[i]]++] = keys[i];
+    }
+    std::copy(buffer, buffer + size, keys);
+    size_t start = counts[0];
+    for (size_t c = 1; c < alphabetSize; ++c) {
+      if (counts[c] > 1) {
+        msdRadixSort(keys + start, buffer, cache + start, counts[c], depth + 1, level + 1);
+      }
+      start += counts[c];
+    }
+  }
+}
+
+namespace gorbunova {
+  template< typename Iter >
+  void stringSort(Iter first, Iter last, bool descending = false)
+  {
+    std::vector< StringKey > keys;
+    for (Iter it = first; it != last; ++it) {
+      keys.push_back(std::addressof(*it));
+    }
+    std::vector< StringKey > buffer(keys.size());
+    std::vector< uint16_t > cache(keys.size());
+    msdRadixSort(keys.data(), buffer.data(), cache.data(), keys.size(), 0);
+    if (descending) {
+      std::reverse(keys.begin(), keys.end());
+    }
+    std::vector< std::string > sorted;
+    sorted.reserve(keys.size());
+    for (StringKey key : keys) {
+      sorted.push_back(std::move(*key));
+    }
+    auto it = sorted.begin();
+    for (Iter current = first; current != last; ++current, ++it) {
+      *current = std::move(*it);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "ThreadPool.hpp"
+
+gorbunova::ThreadPool::ThreadPool(size_t threads):
+  stopping_(false)
+{
+  if (threads == 0) {
+    threads = 1;
+  }
+  try {
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back(&ThreadPool::work, this);
+    }
+  } catch (...) {
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+    throw;
+  }
+}
+
+gorbunova::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t gorbunova::ThreadPool::getSize() const noexcept
+{
+  return workers_.size();
+}
+
+void gorbunova::ThreadPool::work()
+{
+  while (true) {
+    std::function< void() > task;
+    {
+      std::unique_lock< std::mutex > lock(mutex_);
+      ready_.wait(lock, [this]() {
+        return stopping_ || !tasks_.empty();
+      });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gorbunova {
+  class ThreadPool {
+    public:
+    explicit ThreadPool(size_t threads);
+    ThreadPool(const ThreadPool&) = delete;
+    ~ThreadPool();
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getSize() const noexcept;
+
+    template< typename F >
+    std::future< std::invoke_result_t< F > > submit(F task);
+
+    private:
+    std::vector< std::thread > workers_;
+    std::queue< std::function< void() > > tasks_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool stopping_;
+
+    void work();
+  };
+
+  template< typename F >
+  std::future< std::invoke_result_t< F > > ThreadPool::submit(F task)
+  {
+    using result = std::invoke_result_t< F >;
+    auto packaged = std::make_shared< std::packaged_task< result() > >(std::move(task));
+    std::future< result > future = packaged->get_future();
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      tasks_.emplace([packaged]() {
+        (*packaged)();
+      });
+    }
+    ready_.notify_one();
+    return future;
+  }
+}
+#endif
@@ -0,0 +1,105 @@
+#ifndef VERIFY_HPP
+#define VERIFY_HPP
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "ThreadPool.hpp"
+
+namespace {
+  template< typename Iter >
+  constexpr bool isRandomAccess = std::is_base_of_v< std::random_access_iterator_tag,
+      typename std::iterator_traits< Iter >::iterator_category >;
+
+  constexpr uint64_t mixHash(uint64_t value)
+  {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+  }
+
+  template< typename Iter, typename Compare >
+  bool isSortedRange(Iter first, Iter last, const Compare& cmp)
+  {
+    if (first == last) {
+      return true;
+    }
+    for (Iter next = std::next(first); next != last; ++first, ++next) {
+      if (cmp(*next, *first)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template< typename Iter >
+  uint64_t checksumRange(Iter first, Iter last)
+  {
+    using value = typename std::iterator_traits< Iter >::value_type;
+    uint64_t sum = 0;
+    for (; first != last; ++first) {
+      sum += mixHash(std::hash< value >()(*first));
+    }
+    return sum;
+  }
+
+  template< typename Iter, typename F >
+  std::vector< std::invoke_result_t< F, Iter, Iter > > reduceChunks(Iter first, Iter last,
+      gorbunova::ThreadPool* pool, F f)
+  {
+    using result = std::invoke_result_t< F, Iter, Iter >;
+    std::vector< result > results;
+    if constexpr (isRandomAccess< Iter >) {
+      auto size = last - first;
+      auto chunks = pool ? static_cast< decltype(size) >(pool->getSize()) : 1;
+      if (chunks > 1 && size > chunks) {
+        std::vector< std::future< result > > futures;
+        for (decltype(size) i = 0; i < chunks; ++i) {
+          Iter begin = first + size * i / chunks;
+          Iter end = first + size * (i + 1) / chunks;
+          futures.push_back(pool->submit([f, begin, end]() {
+            return f(begin, end);
+          }));
+        }
+        for (auto& future : futures) {
+          results.push_back(future.get());
+        }
+        return results;
+      }
+    }
+    results.push_back(f(first, last));
+    return results;
+  }
+}
+
+namespace gorbunova {
+  template< typename Iter, typename Compare >
+  bool isSorted(Iter first, Iter last, Compare cmp, ThreadPool* pool = nullptr)
+  {
+    auto chunkSorted = [&cmp, last](Iter begin, Iter end) {
+      return isSortedRange(begin, end == last ? end : std::next(end), cmp);
+    };
+    for (bool sorted : reduceChunks(first, last, pool, chunkSorted)) {
+      if (!sorted) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template< typename Iter >
+  uint64_t multisetChecksum(Iter first, Iter last, ThreadPool* pool = nullptr)
+  {
+    uint64_t sum = 0;
+    for (uint64_t part : reduceChunks(first, last, pool, checksumRange< Iter >)) {
+      sum += part;
+    }
+    return sum;
+  }
+}
+
+#endif
@@ -1,15 +1,103 @@
 #include <iostream>
 #include <deque>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
+#include <memory>
+#include <thread>
+#include <type_traits>
 #include "SortCollections.hpp"
 #include "StreamGuard.hpp"
+#include "RunOptions.hpp"
+#include "SortServer.hpp"
+#include "Benchmark.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+  template< typename T >
+  bool run(std::ostream& out, size_t size, const std::string& direction, const gorbunova::RunOptions& options)
+  {
+    if (options.benchmark) {
+      gorbunova::benchmarkStaging< T >(out, size, direction);
+      gorbunova::benchmarkPartition< T >(out, size, direction);
+      gorbunova::benchmarkBatch< T >(out, size);
+      gorbunova::benchmarkSegmented< T >(out, size, direction);
+      gorbunova::benchmarkMemory< T >(out, size, direction);
+      gorbunova::benchmarkLazy< T >(out, size, direction);
+      gorbunova::benchmarkDistribution< T >(out, size, direction);
+      gorbunova::benchmarkTraversal< T >(out, size);
+      gorbunova::benchmarkCompact< T >(out, size, direction);
+      gorbunova::benchmarkIndirect< T >(out, size, direction);
+      gorbunova::benchmarkIngestion< T >(out, size);
+      return true;
+    }
+    if (options.processes != 0 && !std::is_trivially_copyable_v< T >) {
+      throw std::logic_error("Invalid option!");
+    }
+    std::unique_ptr< gorbunova::ThreadPool > pool;
+    if (options.threads != 0) {
+      pool = std::make_unique< gorbunova::ThreadPool >(options.threads);
+    }
+    std::deque< T > data;
+    if (options.input.empty()) {
+      data = generateCollection< T >(size);
+    } else if (options.input == "-") {
+      data = readCollection< T >(std::cin, size);
+    } else {
+      std::ifstream in(options.input);
+      if (!in) {
+        throw std::logic_error("Invalid input!");
+      }
+      data = readCollection< T >(in, size);
+    }
+    gorbunova::SortCollections< T > collections(std::move(data), direction, pool.get());
+    collections.setMemoryBudget(options.memoryBudget);
+    collections.setProcesses(options.processes);
+    if (options.hybrid) {
+      collections.setMode(gorbunova::SortMode::hybrid);
+    }
+    if (options.indirect) {
+      collections.setMode(gorbunova::SortMode::indirect);
+    }
+    if (options.distribution) {
+      collections.setMode(gorbunova::SortMode::distribution);
+    }
+    if (options.automatic) {
+      collections.setMode(gorbunova::SortMode::automatic);
+      collections.setLog(&std::cerr);
+    }
+    if (options.verify) {
+      return collections.verifyCollections(out);
+    }
+    if (options.head != SIZE_MAX) {
+      collections.printHeads(out, options.head) << "\n";
+      return true;
+    }
+    collections.printCollections(out) << "\n";
+    return true;
+  }
+}
 
 int main(int argv, char** argc)
 {
   std::srand(std::time(nullptr));
 
-  if (argv != 4) {
+  if (argv >= 2 && std::string(argc[1]) == "server") {
+    try {
+      gorbunova::SortServer server(std::thread::hardware_concurrency());
+      if (argv >= 3) {
+        server.listen(argc[2]);
+      } else {
+        server.serve(std::cin, std::cout);
+      }
+    } catch (...) {
+      std::cerr << "<INVALID COMMAND>\n";
+      return 1;
+    }
+    return 0;
+  }
+
+  if (argv < 4) {
     std::cerr << "Invalid amount of arguments arguments!\n";
     return 1;
   }
@@ -18,14 +106,15 @@ int main(int argv, char** argc)
     size_t size = std::stoull(argc[3]);
     std::string direction = argc[1];
     std::string type = argc[2];
+    gorbunova::RunOptions options = gorbunova::parseOptions(argv - 4, argc + 4);
     if (type == "ints") {
-      gorbunova::SortCollections< int > collections(size, direction);
-      collections.printCollections(std::cout) << "\n";
+      return run< int >(std::cout, size, direction, options) ? 0 : 1;
     } else if (type == "floats") {
-      gorbunova::SortCollections< float > collections(size, direction);
       gorbunova::StreamGuard guard(std::cout);
       std::cout << std::fixed << std::setprecision(1);
-      collections.printCollections(std::cout) << "\n";
+      return run< float >(std::cout, size, direction, options) ? 0 : 1;
+    } else if (type == "strings") {
+      return run< std::string >(std::cout, size, direction, options) ? 0 : 1;
     } else {
       throw std::logic_error("Invalid type!");
     }